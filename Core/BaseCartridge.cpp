@@ -534,6 +534,20 @@ void BaseCartridge::InitCoprocessor()
 	} else if (hle) {
 		_coprocessor.reset(NecDspHle::InitCoprocessor(_coprocessorType, _console));
 	}
+
+	UpdateCoprocessorSyncQuantum();
+}
+
+void BaseCartridge::UpdateCoprocessorSyncQuantum()
+{
+	//Only the SA-1, GSU and CX4 sync themselves before the main CPU accesses their shared resources,
+	//the other coprocessors must stay in lockstep with the main CPU.
+	//Lockstep is also used while debugging, to keep stepping/breakpoints accurate.
+	if((_sa1 || _gsu || _cx4) && !_console->IsDebugging()) {
+		_coprocSyncQuantum = _console->GetSettings()->GetEmulationConfig().CoprocessorSyncQuantum;
+	} else {
+		_coprocSyncQuantum = 0;
+	}
 }
 
 bool BaseCartridge::MapSpecificCarts(MemoryMappings &mm)
@@ -667,6 +681,13 @@ void BaseCartridge::SetupCpuHalt()
 
 void BaseCartridge::Serialize(Serializer &s)
 {
+	if(_needCoprocSync) {
+		if(s.IsSaving()) {
+			_coprocessor->Run();
+		}
+		_nextCoprocSync = 0;
+	}
+
 	s.StreamArray(_saveRam, _saveRamSize);
 	if(_coprocessor) {
 		s.Stream(_coprocessor.get());
@@ -841,6 +862,13 @@ void BaseCartridge::RunCoprocessors()
 	if(_necDsp) {
 		_necDsp->Run();
 	}
+
+	if(_needCoprocSync) {
+		//Catch up the lazily synced coprocessors at the end of each frame
+		_coprocessor->Run();
+		_nextCoprocSync = 0;
+		UpdateCoprocessorSyncQuantum();
+	}
 }
 
 BaseCoprocessor* BaseCartridge::GetCoprocessor()
@@ -31,6 +31,8 @@ private:
 	uint32_t _headerOffset = 0;
 
 	bool _needCoprocSync = false;
+	uint32_t _coprocSyncQuantum = 0;
+	uint64_t _nextCoprocSync = 0;
 	unique_ptr<BaseCoprocessor> _coprocessor;
 	
 	NecDsp *_necDsp = nullptr;
@@ -76,6 +78,7 @@ private:
 	bool LoadGameboy(VirtualFile& romFile, bool sgbEnabled);
 	void SetupCpuHalt();
 	void InitCoprocessor();
+	void UpdateCoprocessorSyncQuantum();
 	void LoadEmbeddedFirmware();
 
 	string GetCartName();
@@ -117,14 +120,27 @@ public:
 
 	void RunCoprocessors();
 	
-	__forceinline void SyncCoprocessors()
+	__forceinline void SyncCoprocessors(uint64_t masterClock)
 	{
-		if(_needCoprocSync) {
+		//The coprocessor is only caught up once per quantum here - the handlers it shares with the
+		//main CPU (registers, RAM, etc.) also catch it up before every access made by the main CPU
+		if(_needCoprocSync && masterClock >= _nextCoprocSync) {
+			_nextCoprocSync = masterClock + _coprocSyncQuantum;
+			_coprocessor->Run();
+		}
+	}
+
+	__forceinline void SyncCoprocessorIrq()
+	{
+		//Called before the main CPU samples its IRQ line - when the coprocessor is synced once per quantum,
+		//an IRQ it raises (e.g SA-1 -> CPU) would otherwise only be seen up to a full quantum later
+		if(_coprocSyncQuantum) {
 			_coprocessor->Run();
 		}
 	}
 
 	BaseCoprocessor* GetCoprocessor();
+	bool NeedsCoprocessorSync() { return _needCoprocSync; }
 
 	vector<unique_ptr<IMemoryHandler>>& GetPrgRomHandlers();
 	vector<unique_ptr<IMemoryHandler>>& GetSaveRamHandlers();
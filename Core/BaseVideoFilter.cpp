@@ -7,6 +7,11 @@
 #include "../Utilities/FolderUtilities.h"
 #include "Console.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define SCANLINE_EFFECT_USE_SSE2
+#endif
+
 BaseVideoFilter::BaseVideoFilter(shared_ptr<Console> console)
 {
 	_console = console;
@@ -21,7 +26,9 @@ BaseVideoFilter::~BaseVideoFilter()
 
 void BaseVideoFilter::SetBaseFrameInfo(FrameInfo frameInfo)
 {
+	//The overscan is updated here (rather than in SendFrame) so that GetFrameInfo() returns the size of the frame that will be sent next
 	_baseFrameInfo = frameInfo;
+	_overscan = _console->GetSettings()->GetOverscan();
 }
 
 FrameInfo BaseVideoFilter::GetFrameInfo()
@@ -65,12 +72,26 @@ uint32_t BaseVideoFilter::GetBufferSize()
 	return _bufferSize * sizeof(uint32_t);
 }
 
-void BaseVideoFilter::SendFrame(uint16_t *ppuOutputBuffer, uint32_t frameNumber)
+uint32_t BaseVideoFilter::GetOutputPitch()
+{
+	return _framePitch;
+}
+
+void BaseVideoFilter::SendFrame(uint16_t *ppuOutputBuffer, uint32_t frameNumber, uint32_t *frameBuffer, uint32_t pitch)
 {
 	_frameLock.Acquire();
-	_overscan = _console->GetSettings()->GetOverscan();
 	_isOddFrame = frameNumber % 2;
 	UpdateBufferSize();
+
+	//Write the frame directly into the given buffer (with its own pitch) when there is one, instead of _outputBuffer
+	if(frameBuffer && pitch >= GetFrameInfo().Width) {
+		_frameBuffer = frameBuffer;
+		_framePitch = pitch;
+	} else {
+		_frameBuffer = _outputBuffer;
+		_framePitch = GetFrameInfo().Width;
+	}
+
 	OnBeforeApplyFilter();
 	ApplyFilter(ppuOutputBuffer);
 
@@ -79,7 +100,7 @@ void BaseVideoFilter::SendFrame(uint16_t *ppuOutputBuffer, uint32_t frameNumber)
 
 uint32_t* BaseVideoFilter::GetOutputBuffer()
 {
-	return _outputBuffer;
+	return _frameBuffer;
 }
 
 uint32_t BaseVideoFilter::ApplyScanlineEffect(uint32_t argb, uint8_t scanlineIntensity)
@@ -91,6 +112,31 @@ uint32_t BaseVideoFilter::ApplyScanlineEffect(uint32_t argb, uint8_t scanlineInt
 	return 0xFF000000 | (r << 16) | (g << 8) | b;
 }
 
+void BaseVideoFilter::ApplyScanlineEffect(uint32_t *argb, uint32_t count, uint8_t scanlineIntensity)
+{
+	uint32_t i = 0;
+
+#ifdef SCANLINE_EFFECT_USE_SSE2
+	//Same result as the per-pixel version: each channel is multiplied by the intensity, and divided by 255 with (x * 0x8081) >> 23 (exact for all 16-bit values)
+	__m128i zero = _mm_setzero_si128();
+	__m128i intensity = _mm_set1_epi16(scanlineIntensity);
+	__m128i divide = _mm_set1_epi16((int16_t)0x8081);
+	__m128i alpha = _mm_set1_epi32((int32_t)0xFF000000);
+	for(; i + 4 <= count; i += 4) {
+		__m128i pixels = _mm_loadu_si128((__m128i*)(argb + i));
+		__m128i low = _mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), intensity);
+		__m128i high = _mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), intensity);
+		low = _mm_srli_epi16(_mm_mulhi_epu16(low, divide), 7);
+		high = _mm_srli_epi16(_mm_mulhi_epu16(high, divide), 7);
+		_mm_storeu_si128((__m128i*)(argb + i), _mm_or_si128(_mm_packus_epi16(low, high), alpha));
+	}
+#endif
+
+	for(; i < count; i++) {
+		argb[i] = ApplyScanlineEffect(argb[i], scanlineIntensity);
+	}
+}
+
 void BaseVideoFilter::TakeScreenshot(VideoFilterType filterType, string filename, std::stringstream *stream)
 {
 	uint32_t* pngBuffer;
@@ -98,12 +144,13 @@ void BaseVideoFilter::TakeScreenshot(VideoFilterType filterType, string filename
 	uint32_t* frameBuffer = nullptr;
 	{
 		auto lock = _frameLock.AcquireSafe();
-		if(_bufferSize == 0 || !GetOutputBuffer()) {
+		if(_bufferSize == 0 || !_outputBuffer || _frameBuffer != _outputBuffer) {
+			//The last frame was written to the rendering device's buffer, which may no longer be valid
 			return;
 		}
 
 		frameBuffer = new uint32_t[_bufferSize];
-		memcpy(frameBuffer, GetOutputBuffer(), _bufferSize * sizeof(frameBuffer[0]));
+		memcpy(frameBuffer, _outputBuffer, _bufferSize * sizeof(frameBuffer[0]));
 		frameInfo = GetFrameInfo();
 	}
 
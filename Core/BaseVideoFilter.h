@@ -10,6 +10,10 @@ class BaseVideoFilter
 private:
 	uint32_t* _outputBuffer = nullptr;
 	uint32_t _bufferSize = 0;
+
+	//Buffer the current frame is written to: _outputBuffer, or a buffer provided by the rendering device
+	uint32_t* _frameBuffer = nullptr;
+	uint32_t _framePitch = 0;
 	SimpleLock _frameLock;
 	OverscanDimensions _overscan;
 	bool _isOddFrame;
@@ -24,18 +28,22 @@ protected:
 	virtual void OnBeforeApplyFilter();
 	bool IsOddFrame();
 	uint32_t GetBufferSize();
-	uint32_t ApplyScanlineEffect(uint32_t argb, uint8_t scanlineIntensity);
+	uint32_t GetOutputPitch();
+	static uint32_t ApplyScanlineEffect(uint32_t argb, uint8_t scanlineIntensity);
 
 public:
 	BaseVideoFilter(shared_ptr<Console> console);
 	virtual ~BaseVideoFilter();
 
 	uint32_t* GetOutputBuffer();
-	void SendFrame(uint16_t *ppuOutputBuffer, uint32_t frameNumber);
+	void SendFrame(uint16_t *ppuOutputBuffer, uint32_t frameNumber, uint32_t *frameBuffer = nullptr, uint32_t pitch = 0);
 	void TakeScreenshot(string romName, VideoFilterType filterType);
 	void TakeScreenshot(VideoFilterType filterType, string filename, std::stringstream *stream = nullptr);
 
 	virtual OverscanDimensions GetOverscan();
+
+	//Darkens a row of pixels (used for the odd rows when the scanline effect is enabled)
+	static void ApplyScanlineEffect(uint32_t *argb, uint32_t count, uint8_t scanlineIntensity);
 	
 	void SetBaseFrameInfo(FrameInfo frameInfo);
 	virtual FrameInfo GetFrameInfo();
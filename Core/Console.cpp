@@ -114,6 +114,11 @@ void Console::RunSingleFrame()
 {
 	_controlManager->UpdateInputState();
 	_internalRegisters->ProcessAutoJoypadRead();
+	_cpu->StartFrame();
+
+	if(_settings->GetEmulationConfig().LogPerformanceCounters) {
+		LogPerformanceCounters();
+	}
 
 	RunFrame();
 
@@ -125,6 +130,32 @@ void Console::RunSingleFrame()
 	_controlManager->UpdateControlDevices();
 }
 
+void Console::LogPerformanceCounters()
+{
+	//Called at the start of each frame, the counters below all hold the values for the previous frame
+	_perfCpuIdleCyclesSkipped += _cpu->GetSkippedIdleCycles();
+	_perfSpcIdleCyclesSkipped += _spc->GetSkippedIdleCycles();
+
+	PpuLineCacheStats lineCacheStats = _ppu->GetLineCacheStats();
+	_perfLineCacheHits += lineCacheStats.Hits;
+	_perfLineCacheMisses += lineCacheStats.Misses;
+
+	_perfCounterFrames++;
+	if(_perfCounterFrames >= Console::PerfCounterLogInterval) {
+		MessageManager::Log(
+			"[Perf] CPU idle loop cycles skipped: " + std::to_string(_perfCpuIdleCyclesSkipped / _perfCounterFrames) + "/frame" +
+			", SPC idle loop cycles skipped: " + std::to_string(_perfSpcIdleCyclesSkipped / _perfCounterFrames) + "/frame" +
+			", Line cache hits/misses: " + std::to_string(_perfLineCacheHits) + "/" + std::to_string(_perfLineCacheMisses)
+		);
+
+		_perfCounterFrames = 0;
+		_perfCpuIdleCyclesSkipped = 0;
+		_perfSpcIdleCyclesSkipped = 0;
+		_perfLineCacheHits = 0;
+		_perfLineCacheMisses = 0;
+	}
+}
+
 void Console::Stop(bool sendNotification)
 {
 	_stopFlag = true;
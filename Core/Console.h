@@ -53,6 +53,13 @@ private:
 
 	shared_ptr<Debugger> _debugger;
 
+#ifdef LIBRETRO
+	//Libretro builds never attach a debugger, which compiles the debugger hooks below out of every CPU/memory core
+	static constexpr bool DebuggerSupported = false;
+#else
+	static constexpr bool DebuggerSupported = true;
+#endif
+
 	shared_ptr<NotificationManager> _notificationManager;
 	shared_ptr<BatteryManager> _batteryManager;
 	shared_ptr<SoundMixer> _soundMixer;
@@ -81,7 +88,16 @@ private:
 
 	bool _frameRunning = false;
 
+	//Performance counters, accumulated over PerfCounterLogInterval frames before being logged
+	static constexpr uint32_t PerfCounterLogInterval = 60;
+	uint32_t _perfCounterFrames = 0;
+	uint64_t _perfCpuIdleCyclesSkipped = 0;
+	uint64_t _perfSpcIdleCyclesSkipped = 0;
+	uint64_t _perfLineCacheHits = 0;
+	uint64_t _perfLineCacheMisses = 0;
+
 	void UpdateRegion();
+	void LogPerformanceCounters();
 
 	void RunFrame();
 
@@ -147,58 +163,63 @@ public:
 	uint32_t GetFrameCount();	
 	double GetFps();
 
+	__forceinline bool IsDebugging()
+	{
+		return DebuggerSupported && _debugger != nullptr;
+	}
+
 	template<CpuType type> __forceinline void ProcessMemoryRead(uint32_t addr, uint8_t value, MemoryOperationType opType)
 	{
-		if(_debugger) {
+		if(IsDebugging()) {
 			_debugger->ProcessMemoryRead<type>(addr, value, opType);
 		}
 	}
 
 	template<CpuType type> __forceinline void ProcessMemoryWrite(uint32_t addr, uint8_t value, MemoryOperationType opType)
 	{
-		if(_debugger) {
+		if(IsDebugging()) {
 			_debugger->ProcessMemoryWrite<type>(addr, value, opType);
 		}
 	}
 
 	__forceinline void ProcessPpuRead(uint32_t addr, uint8_t value, SnesMemoryType memoryType)
 	{
-		if(_debugger) {
+		if(IsDebugging()) {
 			_debugger->ProcessPpuRead(addr, value, memoryType);
 		}
 	}
 
 	__forceinline void ProcessPpuWrite(uint32_t addr, uint8_t value, SnesMemoryType memoryType)
 	{
-		if(_debugger) {
+		if(IsDebugging()) {
 			_debugger->ProcessPpuWrite(addr, value, memoryType);
 		}
 	}
 
 	__forceinline void ProcessWorkRamRead(uint32_t addr, uint8_t value)
 	{
-		if(_debugger) {
+		if(IsDebugging()) {
 			_debugger->ProcessWorkRamRead(addr, value);
 		}
 	}
 
 	__forceinline void ProcessWorkRamWrite(uint32_t addr, uint8_t value)
 	{
-		if(_debugger) {
+		if(IsDebugging()) {
 			_debugger->ProcessWorkRamWrite(addr, value);
 		}
 	}
 	
 	template<CpuType cpuType> __forceinline void ProcessPpuCycle()
 	{
-		if(_debugger) {
+		if(IsDebugging()) {
 			_debugger->ProcessPpuCycle<cpuType>();
 		}
 	}
 
 	__forceinline void DebugLog(string log)
 	{
-		if(_debugger) {
+		if(IsDebugging()) {
 			_debugger->Log(log);
 		}
 	}
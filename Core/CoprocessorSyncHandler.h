@@ -0,0 +1,47 @@
+#pragma once
+#include "stdafx.h"
+#include "IMemoryHandler.h"
+#include "BaseCoprocessor.h"
+
+//Wraps a handler the main CPU shares with a coprocessor
+//Catches up the coprocessor before the main CPU reads/writes to it
+class CoprocessorSyncHandler : public IMemoryHandler
+{
+private:
+	IMemoryHandler* _handler;
+	BaseCoprocessor* _coprocessor;
+
+public:
+	CoprocessorSyncHandler(IMemoryHandler* handler, BaseCoprocessor* coprocessor) : IMemoryHandler(handler->GetMemoryType())
+	{
+		_handler = handler;
+		_coprocessor = coprocessor;
+	}
+
+	uint8_t Read(uint32_t addr) override
+	{
+		_coprocessor->Run();
+		return _handler->Read(addr);
+	}
+
+	uint8_t Peek(uint32_t addr) override
+	{
+		return _handler->Peek(addr);
+	}
+
+	void PeekBlock(uint32_t addr, uint8_t *output) override
+	{
+		_handler->PeekBlock(addr, output);
+	}
+
+	void Write(uint32_t addr, uint8_t value) override
+	{
+		_coprocessor->Run();
+		_handler->Write(addr, value);
+	}
+
+	AddressInfo GetAbsoluteAddress(uint32_t address) override
+	{
+		return _handler->GetAbsoluteAddress(address);
+	}
+};
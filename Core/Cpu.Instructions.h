@@ -70,9 +70,9 @@ void Cpu::Add16(uint16_t value)
 	_state.A = (uint16_t)result;
 }
 
-void Cpu::ADC()
+template<uint8_t flags> void Cpu::ADC()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(flags & ProcFlags::MemoryMode8) {
 		Add8(GetByteValue());
 	} else {
 		Add16(GetWordValue());
@@ -148,9 +148,9 @@ void Cpu::Sub16(uint16_t value)
 	_state.A = (uint16_t)result;
 }
 
-void Cpu::SBC()
+template<uint8_t flags> void Cpu::SBC()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(flags & ProcFlags::MemoryMode8) {
 		Sub8(~GetByteValue());
 	} else {
 		Sub16(~GetWordValue());
@@ -283,54 +283,54 @@ void Cpu::SEP()
 /******************************
 Increment/decrement operations
 *******************************/
-void Cpu::DEX()
+template<uint8_t flags> void Cpu::DEX()
 {
-	IncDecReg(_state.X, -1);
+	IncDecReg<flags>(_state.X, -1);
 }
 
-void Cpu::DEY()
+template<uint8_t flags> void Cpu::DEY()
 {
-	IncDecReg(_state.Y, -1);
+	IncDecReg<flags>(_state.Y, -1);
 }
 
-void Cpu::INX()
+template<uint8_t flags> void Cpu::INX()
 {
-	IncDecReg(_state.X, 1);
+	IncDecReg<flags>(_state.X, 1);
 }
 
-void Cpu::INY()
+template<uint8_t flags> void Cpu::INY()
 {
-	IncDecReg(_state.Y, 1);
+	IncDecReg<flags>(_state.Y, 1);
 }
 
-void Cpu::DEC()
+template<uint8_t flags> void Cpu::DEC()
 {
-	IncDec(-1);
+	IncDec<flags>(-1);
 }
 
-void Cpu::INC()
+template<uint8_t flags> void Cpu::INC()
 {
-	IncDec(1);
+	IncDec<flags>(1);
 }
 
-void Cpu::DEC_Acc()
+template<uint8_t flags> void Cpu::DEC_Acc()
 {
-	SetRegister(_state.A, _state.A - 1, CheckFlag(ProcFlags::MemoryMode8));
+	SetRegister(_state.A, _state.A - 1, (flags & ProcFlags::MemoryMode8));
 }
 
-void Cpu::INC_Acc()
+template<uint8_t flags> void Cpu::INC_Acc()
 {
-	SetRegister(_state.A, _state.A + 1, CheckFlag(ProcFlags::MemoryMode8));
+	SetRegister(_state.A, _state.A + 1, (flags & ProcFlags::MemoryMode8));
 }
 
-void Cpu::IncDecReg(uint16_t &reg, int8_t offset)
+template<uint8_t flags> void Cpu::IncDecReg(uint16_t &reg, int8_t offset)
 {
-	SetRegister(reg, reg + offset, CheckFlag(ProcFlags::IndexMode8));
+	SetRegister(reg, reg + offset, (flags & ProcFlags::IndexMode8));
 }
 
-void Cpu::IncDec(int8_t offset)
+template<uint8_t flags> void Cpu::IncDec(int8_t offset)
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(flags & ProcFlags::MemoryMode8) {
 		uint8_t value = GetByteValue() + offset;
 		SetZeroNegativeFlags(value);
 		Idle();
@@ -370,19 +370,19 @@ void Cpu::Compare(uint16_t reg, bool eightBitMode)
 	}
 }
 
-void Cpu::CMP()
+template<uint8_t flags> void Cpu::CMP()
 {
-	Compare(_state.A, CheckFlag(ProcFlags::MemoryMode8));
+	Compare(_state.A, (flags & ProcFlags::MemoryMode8));
 }
 
-void Cpu::CPX()
+template<uint8_t flags> void Cpu::CPX()
 {
-	Compare(_state.X, CheckFlag(ProcFlags::IndexMode8));
+	Compare(_state.X, (flags & ProcFlags::IndexMode8));
 }
 
-void Cpu::CPY()
+template<uint8_t flags> void Cpu::CPY()
 {
-	Compare(_state.Y, CheckFlag(ProcFlags::IndexMode8));
+	Compare(_state.Y, (flags & ProcFlags::IndexMode8));
 }
 
 /*****************
@@ -502,27 +502,27 @@ void Cpu::COP()
 /******************
 Bitwise operations
 *******************/
-void Cpu::AND()
+template<uint8_t flags> void Cpu::AND()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(flags & ProcFlags::MemoryMode8) {
 		SetRegister(_state.A, _state.A & GetByteValue(), true);
 	} else {
 		SetRegister(_state.A, _state.A & GetWordValue(), false);
 	}
 }
 
-void Cpu::EOR()
+template<uint8_t flags> void Cpu::EOR()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(flags & ProcFlags::MemoryMode8) {
 		SetRegister(_state.A, _state.A ^ GetByteValue(), true);
 	} else {
 		SetRegister(_state.A, _state.A ^ GetWordValue(), false);
 	}
 }
 
-void Cpu::ORA()
+template<uint8_t flags> void Cpu::ORA()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(flags & ProcFlags::MemoryMode8) {
 		SetRegister(_state.A, _state.A | GetByteValue(), true);
 	} else {
 		SetRegister(_state.A, _state.A | GetWordValue(), false);
@@ -580,18 +580,18 @@ template<typename T> T Cpu::RollRight(T value)
 	return result;
 }
 
-void Cpu::ASL_Acc()
+template<uint8_t flags> void Cpu::ASL_Acc()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(flags & ProcFlags::MemoryMode8) {
 		_state.A = (_state.A & 0xFF00) | (ShiftLeft<uint8_t>((uint8_t)_state.A));
 	} else {
 		_state.A = ShiftLeft<uint16_t>(_state.A);
 	}
 }
 
-void Cpu::ASL()
+template<uint8_t flags> void Cpu::ASL()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(flags & ProcFlags::MemoryMode8) {
 		uint8_t value = GetByteValue();
 		Idle();
 		Write(_operand, ShiftLeft<uint8_t>(value));
@@ -602,18 +602,18 @@ void Cpu::ASL()
 	}
 }
 
-void Cpu::LSR_Acc()
+template<uint8_t flags> void Cpu::LSR_Acc()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(flags & ProcFlags::MemoryMode8) {
 		_state.A = (_state.A & 0xFF00) | ShiftRight<uint8_t>((uint8_t)_state.A);
 	} else {
 		_state.A = ShiftRight<uint16_t>(_state.A);
 	}
 }
 
-void Cpu::LSR()
+template<uint8_t flags> void Cpu::LSR()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(flags & ProcFlags::MemoryMode8) {
 		uint8_t value = GetByteValue();
 		Idle();
 		Write(_operand, ShiftRight<uint8_t>(value));
@@ -624,18 +624,18 @@ void Cpu::LSR()
 	}
 }
 
-void Cpu::ROL_Acc()
+template<uint8_t flags> void Cpu::ROL_Acc()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(flags & ProcFlags::MemoryMode8) {
 		_state.A = (_state.A & 0xFF00) | RollLeft<uint8_t>((uint8_t)_state.A);
 	} else {
 		_state.A = RollLeft<uint16_t>(_state.A);
 	}
 }
 
-void Cpu::ROL()
+template<uint8_t flags> void Cpu::ROL()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(flags & ProcFlags::MemoryMode8) {
 		uint8_t value = GetByteValue();
 		Idle();
 		Write(_operand, RollLeft<uint8_t>(value));
@@ -646,18 +646,18 @@ void Cpu::ROL()
 	}
 }
 
-void Cpu::ROR_Acc()
+template<uint8_t flags> void Cpu::ROR_Acc()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(flags & ProcFlags::MemoryMode8) {
 		_state.A = (_state.A & 0xFF00) | RollRight<uint8_t>((uint8_t)_state.A);
 	} else {
 		_state.A = RollRight<uint16_t>(_state.A);
 	}
 }
 
-void Cpu::ROR()
+template<uint8_t flags> void Cpu::ROR()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(flags & ProcFlags::MemoryMode8) {
 		uint8_t value = GetByteValue();
 		Idle();
 		Write(_operand, RollRight<uint8_t>(value));
@@ -671,7 +671,7 @@ void Cpu::ROR()
 /***************
 Move operations
 ****************/
-void Cpu::MVN()
+template<uint8_t flags> void Cpu::MVN()
 {
 	_state.DBR = _operand & 0xFF;
 	uint32_t destBank = _state.DBR << 16;
@@ -685,7 +685,7 @@ void Cpu::MVN()
 
 	_state.X++;
 	_state.Y++;
-	if(CheckFlag(ProcFlags::IndexMode8)) {
+	if(flags & ProcFlags::IndexMode8) {
 		_state.X &= 0xFF;
 		_state.Y &= 0xFF;
 	}
@@ -698,7 +698,7 @@ void Cpu::MVN()
 	}
 }
 
-void Cpu::MVP()
+template<uint8_t flags> void Cpu::MVP()
 {
 	_state.DBR = _operand & 0xFF;
 	uint32_t destBank = _state.DBR << 16;
@@ -712,7 +712,7 @@ void Cpu::MVP()
 
 	_state.X--;
 	_state.Y--;
-	if(CheckFlag(ProcFlags::IndexMode8)) {
+	if(flags & ProcFlags::IndexMode8) {
 		_state.X &= 0xFF;
 		_state.Y &= 0xFF;
 	}
@@ -800,45 +800,45 @@ void Cpu::PLP()
 	}
 }
 
-void Cpu::PHA()
+template<uint8_t flags> void Cpu::PHA()
 {
 	//"When the m flag is 0, PHA and PLA push and pull a 16-bit value, and when the m flag is 1, PHA and PLA push and pull an 8-bit value. "
 	Idle();
-	PushRegister(_state.A, CheckFlag(ProcFlags::MemoryMode8));
+	PushRegister(_state.A, (flags & ProcFlags::MemoryMode8));
 }
 
-void Cpu::PHX()
+template<uint8_t flags> void Cpu::PHX()
 {
 	Idle();
-	PushRegister(_state.X, CheckFlag(ProcFlags::IndexMode8));
+	PushRegister(_state.X, (flags & ProcFlags::IndexMode8));
 }
 
-void Cpu::PHY()
+template<uint8_t flags> void Cpu::PHY()
 {
 	Idle();
-	PushRegister(_state.Y, CheckFlag(ProcFlags::IndexMode8));
+	PushRegister(_state.Y, (flags & ProcFlags::IndexMode8));
 }
 
-void Cpu::PLA()
+template<uint8_t flags> void Cpu::PLA()
 {
 	//"When the m flag is 0, PHA and PLA push and pull a 16-bit value, and when the m flag is 1, PHA and PLA push and pull an 8-bit value."
 	Idle();
 	Idle();
-	PullRegister(_state.A, CheckFlag(ProcFlags::MemoryMode8));
+	PullRegister(_state.A, (flags & ProcFlags::MemoryMode8));
 }
 
-void Cpu::PLX()
+template<uint8_t flags> void Cpu::PLX()
 {
 	Idle();
 	Idle();
-	PullRegister(_state.X, CheckFlag(ProcFlags::IndexMode8));
+	PullRegister(_state.X, (flags & ProcFlags::IndexMode8));
 }
 
-void Cpu::PLY()
+template<uint8_t flags> void Cpu::PLY()
 {
 	Idle();
 	Idle();
-	PullRegister(_state.Y, CheckFlag(ProcFlags::IndexMode8));
+	PullRegister(_state.Y, (flags & ProcFlags::IndexMode8));
 }
 
 void Cpu::PushRegister(uint16_t reg, bool eightBitMode)
@@ -882,46 +882,46 @@ void Cpu::StoreRegister(uint16_t val, bool eightBitMode)
 	}
 }
 
-void Cpu::LDA()
+template<uint8_t flags> void Cpu::LDA()
 {
 	//"When the m flag is 0, LDA, STA, and STZ are 16-bit operations"
-	LoadRegister(_state.A, CheckFlag(ProcFlags::MemoryMode8));
+	LoadRegister(_state.A, (flags & ProcFlags::MemoryMode8));
 }
 
-void Cpu::LDX()
+template<uint8_t flags> void Cpu::LDX()
 {
 	//"When the x flag is 0, LDX, LDY, STX, and STY are 16-bit operations"
-	LoadRegister(_state.X, CheckFlag(ProcFlags::IndexMode8));
+	LoadRegister(_state.X, (flags & ProcFlags::IndexMode8));
 }
 
-void Cpu::LDY()
+template<uint8_t flags> void Cpu::LDY()
 {
 	//"When the x flag is 0, LDX, LDY, STX, and STY are 16-bit operations"
-	LoadRegister(_state.Y, CheckFlag(ProcFlags::IndexMode8));
+	LoadRegister(_state.Y, (flags & ProcFlags::IndexMode8));
 }
 
-void Cpu::STA()
+template<uint8_t flags> void Cpu::STA()
 {
 	//"When the m flag is 0, LDA, STA, and STZ are 16-bit operations"
-	StoreRegister(_state.A, CheckFlag(ProcFlags::MemoryMode8));
+	StoreRegister(_state.A, (flags & ProcFlags::MemoryMode8));
 }
 
-void Cpu::STX()
+template<uint8_t flags> void Cpu::STX()
 {
 	//"When the x flag is 0, LDX, LDY, STX, and STY are 16-bit operations"
-	StoreRegister(_state.X, CheckFlag(ProcFlags::IndexMode8));
+	StoreRegister(_state.X, (flags & ProcFlags::IndexMode8));
 }
 
-void Cpu::STY()
+template<uint8_t flags> void Cpu::STY()
 {
 	//"When the x flag is 0, LDX, LDY, STX, and STY are 16-bit operations"
-	StoreRegister(_state.Y, CheckFlag(ProcFlags::IndexMode8));
+	StoreRegister(_state.Y, (flags & ProcFlags::IndexMode8));
 }
 
-void Cpu::STZ()
+template<uint8_t flags> void Cpu::STZ()
 {
 	//"When the m flag is 0, LDA, STA, and STZ are 16-bit operations"
-	StoreRegister(0, CheckFlag(ProcFlags::MemoryMode8));
+	StoreRegister(0, (flags & ProcFlags::MemoryMode8));
 }
 
 /*******************
@@ -952,18 +952,18 @@ template<typename T> void Cpu::TestBits(T value, bool alterZeroFlagOnly)
 	}
 }
 
-void Cpu::BIT()
+template<uint8_t flags> void Cpu::BIT()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(flags & ProcFlags::MemoryMode8) {
 		TestBits<uint8_t>(GetByteValue(), _immediateMode);
 	} else {
 		TestBits<uint16_t>(GetWordValue(), _immediateMode);
 	}
 }
 
-void Cpu::TRB()
+template<uint8_t flags> void Cpu::TRB()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(flags & ProcFlags::MemoryMode8) {
 		uint8_t value = GetByteValue();
 		TestBits<uint8_t>(value, true);
 
@@ -982,9 +982,9 @@ void Cpu::TRB()
 	}
 }
 
-void Cpu::TSB()
+template<uint8_t flags> void Cpu::TSB()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(flags & ProcFlags::MemoryMode8) {
 		uint8_t value = GetByteValue();
 		TestBits<uint8_t>(value, true);
 
@@ -1006,14 +1006,14 @@ void Cpu::TSB()
 /******************
 Transfer operations
 *******************/
-void Cpu::TAX()
+template<uint8_t flags> void Cpu::TAX()
 {
-	SetRegister(_state.X, _state.A, CheckFlag(ProcFlags::IndexMode8));
+	SetRegister(_state.X, _state.A, (flags & ProcFlags::IndexMode8));
 }
 
-void Cpu::TAY()
+template<uint8_t flags> void Cpu::TAY()
 {
-	SetRegister(_state.Y, _state.A, CheckFlag(ProcFlags::IndexMode8));
+	SetRegister(_state.Y, _state.A, (flags & ProcFlags::IndexMode8));
 }
 
 void Cpu::TCD()
@@ -1036,14 +1036,14 @@ void Cpu::TSC()
 	SetRegister(_state.A, _state.SP, false);
 }
 
-void Cpu::TSX()
+template<uint8_t flags> void Cpu::TSX()
 {
-	SetRegister(_state.X, _state.SP, CheckFlag(ProcFlags::IndexMode8));
+	SetRegister(_state.X, _state.SP, (flags & ProcFlags::IndexMode8));
 }
 
-void Cpu::TXA()
+template<uint8_t flags> void Cpu::TXA()
 {
-	SetRegister(_state.A, _state.X, CheckFlag(ProcFlags::MemoryMode8));
+	SetRegister(_state.A, _state.X, (flags & ProcFlags::MemoryMode8));
 }
 
 void Cpu::TXS()
@@ -1051,19 +1051,19 @@ void Cpu::TXS()
 	SetSP(_state.X);
 }
 
-void Cpu::TXY()
+template<uint8_t flags> void Cpu::TXY()
 {
-	SetRegister(_state.Y, _state.X, CheckFlag(ProcFlags::IndexMode8));
+	SetRegister(_state.Y, _state.X, (flags & ProcFlags::IndexMode8));
 }
 
-void Cpu::TYA()
+template<uint8_t flags> void Cpu::TYA()
 {
-	SetRegister(_state.A, _state.Y, CheckFlag(ProcFlags::MemoryMode8));
+	SetRegister(_state.A, _state.Y, (flags & ProcFlags::MemoryMode8));
 }
 
-void Cpu::TYX()
+template<uint8_t flags> void Cpu::TYX()
 {
-	SetRegister(_state.X, _state.Y, CheckFlag(ProcFlags::IndexMode8));
+	SetRegister(_state.X, _state.Y, (flags & ProcFlags::IndexMode8));
 }
 
 void Cpu::XBA()
@@ -1125,20 +1125,20 @@ void Cpu::AddrMode_Abs()
 	_operand = GetDataAddress(ReadOperandWord());
 }
 
-void Cpu::AddrMode_AbsIdxX(bool isWrite)
+template<uint8_t flags> void Cpu::AddrMode_AbsIdxX(bool isWrite)
 {
 	uint32_t baseAddr = GetDataAddress(ReadOperandWord());
 	_operand = (baseAddr + _state.X) & 0xFFFFFF;
-	if(isWrite || !CheckFlag(ProcFlags::IndexMode8) || (_operand & 0xFF00) != (baseAddr & 0xFF00)) {
+	if(isWrite || !(flags & ProcFlags::IndexMode8) || (_operand & 0xFF00) != (baseAddr & 0xFF00)) {
 		Idle();
 	}
 }
 
-void Cpu::AddrMode_AbsIdxY(bool isWrite)
+template<uint8_t flags> void Cpu::AddrMode_AbsIdxY(bool isWrite)
 {
 	uint32_t baseAddr = GetDataAddress(ReadOperandWord());
 	_operand = (baseAddr + _state.Y) & 0xFFFFFF;
-	if(isWrite || !CheckFlag(ProcFlags::IndexMode8) || (_operand & 0xFF00) != (baseAddr & 0xFF00)) {
+	if(isWrite || !(flags & ProcFlags::IndexMode8) || (_operand & 0xFF00) != (baseAddr & 0xFF00)) {
 		Idle();
 	}
 }
@@ -1228,12 +1228,12 @@ void Cpu::AddrMode_DirIdxIndX()
 	_operand = GetDataAddress(GetDirectAddressIndirectWord(operandByte + _state.X));
 }
 
-void Cpu::AddrMode_DirIndIdxY(bool isWrite)
+template<uint8_t flags> void Cpu::AddrMode_DirIndIdxY(bool isWrite)
 {
 	uint32_t baseAddr = GetDataAddress(GetDirectAddressIndirectWord(ReadDirectOperandByte()));
 	_operand = (baseAddr + _state.Y) & 0xFFFFFF;
 	
-	if(isWrite || !CheckFlag(ProcFlags::IndexMode8) || (_operand & 0xFF00) != (baseAddr & 0xFF00)) {
+	if(isWrite || !(flags & ProcFlags::IndexMode8) || (_operand & 0xFF00) != (baseAddr & 0xFF00)) {
 		Idle();
 	}
 }
@@ -1260,16 +1260,16 @@ void Cpu::AddrMode_Imm16()
 	_operand = ReadOperandWord();
 }
 
-void Cpu::AddrMode_ImmX()
+template<uint8_t flags> void Cpu::AddrMode_ImmX()
 {
 	_immediateMode = true;
-	_operand = CheckFlag(ProcFlags::IndexMode8) ? ReadOperandByte() : ReadOperandWord();
+	_operand = (flags & ProcFlags::IndexMode8) ? ReadOperandByte() : ReadOperandWord();
 }
 
-void Cpu::AddrMode_ImmM()
+template<uint8_t flags> void Cpu::AddrMode_ImmM()
 {
 	_immediateMode = true; 
-	_operand = CheckFlag(ProcFlags::MemoryMode8) ? ReadOperandByte() : ReadOperandWord();
+	_operand = (flags & ProcFlags::MemoryMode8) ? ReadOperandByte() : ReadOperandWord();
 }
 
 void Cpu::AddrMode_Imp()
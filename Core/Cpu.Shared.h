@@ -37,265 +37,276 @@ void Cpu::Reset()
 	_state.PrevIrqSource = (uint8_t)IrqSource::None;
 }
 
-void Cpu::RunOp()
+template<uint8_t flags> void Cpu::RunOp()
 {
 	switch(GetOpCode()) {
 		case 0x00: AddrMode_Imm8(); BRK(); break;
-		case 0x01: AddrMode_DirIdxIndX(); ORA(); break;
+		case 0x01: AddrMode_DirIdxIndX(); ORA<flags>(); break;
 		case 0x02: AddrMode_Imm8(); COP(); break;
-		case 0x03: AddrMode_StkRel(); ORA(); break;
-		case 0x04: AddrMode_Dir(); TSB(); break;
-		case 0x05: AddrMode_Dir(); ORA(); break;
-		case 0x06: AddrMode_Dir(); ASL(); break;
-		case 0x07: AddrMode_DirIndLng(); ORA(); break;
+		case 0x03: AddrMode_StkRel(); ORA<flags>(); break;
+		case 0x04: AddrMode_Dir(); TSB<flags>(); break;
+		case 0x05: AddrMode_Dir(); ORA<flags>(); break;
+		case 0x06: AddrMode_Dir(); ASL<flags>(); break;
+		case 0x07: AddrMode_DirIndLng(); ORA<flags>(); break;
 		case 0x08: PHP(); break;
-		case 0x09: AddrMode_ImmM(); ORA(); break;
-		case 0x0A: AddrMode_Acc(); ASL_Acc(); break;
+		case 0x09: AddrMode_ImmM<flags>(); ORA<flags>(); break;
+		case 0x0A: AddrMode_Acc(); ASL_Acc<flags>(); break;
 		case 0x0B: PHD(); break;
-		case 0x0C: AddrMode_Abs(); TSB(); break;
-		case 0x0D: AddrMode_Abs(); ORA(); break;
-		case 0x0E: AddrMode_Abs(); ASL(); break;
-		case 0x0F: AddrMode_AbsLng(); ORA(); break;
+		case 0x0C: AddrMode_Abs(); TSB<flags>(); break;
+		case 0x0D: AddrMode_Abs(); ORA<flags>(); break;
+		case 0x0E: AddrMode_Abs(); ASL<flags>(); break;
+		case 0x0F: AddrMode_AbsLng(); ORA<flags>(); break;
 		case 0x10: AddrMode_Rel(); BPL(); break;
-		case 0x11: AddrMode_DirIndIdxY(false); ORA(); break;
-		case 0x12: AddrMode_DirInd(); ORA(); break;
-		case 0x13: AddrMode_StkRelIndIdxY(); ORA(); break;
-		case 0x14: AddrMode_Dir(); TRB(); break;
-		case 0x15: AddrMode_DirIdxX(); ORA(); break;
-		case 0x16: AddrMode_DirIdxX(); ASL(); break;
-		case 0x17: AddrMode_DirIndLngIdxY(); ORA(); break;
+		case 0x11: AddrMode_DirIndIdxY<flags>(false); ORA<flags>(); break;
+		case 0x12: AddrMode_DirInd(); ORA<flags>(); break;
+		case 0x13: AddrMode_StkRelIndIdxY(); ORA<flags>(); break;
+		case 0x14: AddrMode_Dir(); TRB<flags>(); break;
+		case 0x15: AddrMode_DirIdxX(); ORA<flags>(); break;
+		case 0x16: AddrMode_DirIdxX(); ASL<flags>(); break;
+		case 0x17: AddrMode_DirIndLngIdxY(); ORA<flags>(); break;
 		case 0x18: AddrMode_Imp(); CLC(); break;
-		case 0x19: AddrMode_AbsIdxY(false); ORA(); break;
-		case 0x1A: AddrMode_Acc(); INC_Acc(); break;
+		case 0x19: AddrMode_AbsIdxY<flags>(false); ORA<flags>(); break;
+		case 0x1A: AddrMode_Acc(); INC_Acc<flags>(); break;
 		case 0x1B: AddrMode_Imp(); TCS(); break;
-		case 0x1C: AddrMode_Abs(); TRB(); break;
-		case 0x1D: AddrMode_AbsIdxX(false); ORA(); break;
-		case 0x1E: AddrMode_AbsIdxX(true); ASL(); break;
-		case 0x1F: AddrMode_AbsLngIdxX(); ORA(); break;
+		case 0x1C: AddrMode_Abs(); TRB<flags>(); break;
+		case 0x1D: AddrMode_AbsIdxX<flags>(false); ORA<flags>(); break;
+		case 0x1E: AddrMode_AbsIdxX<flags>(true); ASL<flags>(); break;
+		case 0x1F: AddrMode_AbsLngIdxX(); ORA<flags>(); break;
 		case 0x20: AddrMode_AbsJmp(); Idle(); JSR(); break;
-		case 0x21: AddrMode_DirIdxIndX(); AND(); break;
+		case 0x21: AddrMode_DirIdxIndX(); AND<flags>(); break;
 		case 0x22: AddrMode_AbsLngJmp(); JSL(); break;
-		case 0x23: AddrMode_StkRel(); AND(); break;
-		case 0x24: AddrMode_Dir(); BIT(); break;
-		case 0x25: AddrMode_Dir(); AND(); break;
-		case 0x26: AddrMode_Dir(); ROL(); break;
-		case 0x27: AddrMode_DirIndLng(); AND(); break;
+		case 0x23: AddrMode_StkRel(); AND<flags>(); break;
+		case 0x24: AddrMode_Dir(); BIT<flags>(); break;
+		case 0x25: AddrMode_Dir(); AND<flags>(); break;
+		case 0x26: AddrMode_Dir(); ROL<flags>(); break;
+		case 0x27: AddrMode_DirIndLng(); AND<flags>(); break;
 		case 0x28: PLP(); break;
-		case 0x29: AddrMode_ImmM(); AND(); break;
-		case 0x2A: AddrMode_Acc(); ROL_Acc(); break;
+		case 0x29: AddrMode_ImmM<flags>(); AND<flags>(); break;
+		case 0x2A: AddrMode_Acc(); ROL_Acc<flags>(); break;
 		case 0x2B: PLD(); break;
-		case 0x2C: AddrMode_Abs(); BIT(); break;
-		case 0x2D: AddrMode_Abs(); AND(); break;
-		case 0x2E: AddrMode_Abs(); ROL(); break;
-		case 0x2F: AddrMode_AbsLng(); AND(); break;
+		case 0x2C: AddrMode_Abs(); BIT<flags>(); break;
+		case 0x2D: AddrMode_Abs(); AND<flags>(); break;
+		case 0x2E: AddrMode_Abs(); ROL<flags>(); break;
+		case 0x2F: AddrMode_AbsLng(); AND<flags>(); break;
 		case 0x30: AddrMode_Rel(); BMI(); break;
-		case 0x31: AddrMode_DirIndIdxY(false); AND(); break;
-		case 0x32: AddrMode_DirInd(); AND(); break;
-		case 0x33: AddrMode_StkRelIndIdxY(); AND(); break;
-		case 0x34: AddrMode_DirIdxX(); BIT(); break;
-		case 0x35: AddrMode_DirIdxX(); AND(); break;
-		case 0x36: AddrMode_DirIdxX(); ROL(); break;
-		case 0x37: AddrMode_DirIndLngIdxY(); AND(); break;
+		case 0x31: AddrMode_DirIndIdxY<flags>(false); AND<flags>(); break;
+		case 0x32: AddrMode_DirInd(); AND<flags>(); break;
+		case 0x33: AddrMode_StkRelIndIdxY(); AND<flags>(); break;
+		case 0x34: AddrMode_DirIdxX(); BIT<flags>(); break;
+		case 0x35: AddrMode_DirIdxX(); AND<flags>(); break;
+		case 0x36: AddrMode_DirIdxX(); ROL<flags>(); break;
+		case 0x37: AddrMode_DirIndLngIdxY(); AND<flags>(); break;
 		case 0x38: AddrMode_Imp(); SEC(); break;
-		case 0x39: AddrMode_AbsIdxY(false); AND(); break;
-		case 0x3A: AddrMode_Acc(); DEC_Acc(); break;
+		case 0x39: AddrMode_AbsIdxY<flags>(false); AND<flags>(); break;
+		case 0x3A: AddrMode_Acc(); DEC_Acc<flags>(); break;
 		case 0x3B: AddrMode_Imp(); TSC(); break;
-		case 0x3C: AddrMode_AbsIdxX(false); BIT(); break;
-		case 0x3D: AddrMode_AbsIdxX(false); AND(); break;
-		case 0x3E: AddrMode_AbsIdxX(true); ROL(); break;
-		case 0x3F: AddrMode_AbsLngIdxX(); AND(); break;
+		case 0x3C: AddrMode_AbsIdxX<flags>(false); BIT<flags>(); break;
+		case 0x3D: AddrMode_AbsIdxX<flags>(false); AND<flags>(); break;
+		case 0x3E: AddrMode_AbsIdxX<flags>(true); ROL<flags>(); break;
+		case 0x3F: AddrMode_AbsLngIdxX(); AND<flags>(); break;
 		case 0x40: RTI(); break;
-		case 0x41: AddrMode_DirIdxIndX(); EOR(); break;
+		case 0x41: AddrMode_DirIdxIndX(); EOR<flags>(); break;
 		case 0x42: AddrMode_Imm8(); WDM(); break;
-		case 0x43: AddrMode_StkRel(); EOR(); break;
-		case 0x44: AddrMode_BlkMov(); MVP(); break;
-		case 0x45: AddrMode_Dir(); EOR(); break;
-		case 0x46: AddrMode_Dir(); LSR(); break;
-		case 0x47: AddrMode_DirIndLng(); EOR(); break;
-		case 0x48: PHA(); break;
-		case 0x49: AddrMode_ImmM(); EOR(); break;
-		case 0x4A: AddrMode_Acc(); LSR_Acc(); break;
+		case 0x43: AddrMode_StkRel(); EOR<flags>(); break;
+		case 0x44: AddrMode_BlkMov(); MVP<flags>(); break;
+		case 0x45: AddrMode_Dir(); EOR<flags>(); break;
+		case 0x46: AddrMode_Dir(); LSR<flags>(); break;
+		case 0x47: AddrMode_DirIndLng(); EOR<flags>(); break;
+		case 0x48: PHA<flags>(); break;
+		case 0x49: AddrMode_ImmM<flags>(); EOR<flags>(); break;
+		case 0x4A: AddrMode_Acc(); LSR_Acc<flags>(); break;
 		case 0x4B: PHK(); break;
 		case 0x4C: AddrMode_AbsJmp(); JMP(); break;
-		case 0x4D: AddrMode_Abs(); EOR(); break;
-		case 0x4E: AddrMode_Abs(); LSR(); break;
-		case 0x4F: AddrMode_AbsLng(); EOR(); break;
+		case 0x4D: AddrMode_Abs(); EOR<flags>(); break;
+		case 0x4E: AddrMode_Abs(); LSR<flags>(); break;
+		case 0x4F: AddrMode_AbsLng(); EOR<flags>(); break;
 		case 0x50: AddrMode_Rel(); BVC(); break;
-		case 0x51: AddrMode_DirIndIdxY(false); EOR(); break;
-		case 0x52: AddrMode_DirInd(); EOR(); break;
-		case 0x53: AddrMode_StkRelIndIdxY(); EOR(); break;
-		case 0x54: AddrMode_BlkMov(); MVN(); break;
-		case 0x55: AddrMode_DirIdxX(); EOR(); break;
-		case 0x56: AddrMode_DirIdxX(); LSR(); break;
-		case 0x57: AddrMode_DirIndLngIdxY(); EOR(); break;
+		case 0x51: AddrMode_DirIndIdxY<flags>(false); EOR<flags>(); break;
+		case 0x52: AddrMode_DirInd(); EOR<flags>(); break;
+		case 0x53: AddrMode_StkRelIndIdxY(); EOR<flags>(); break;
+		case 0x54: AddrMode_BlkMov(); MVN<flags>(); break;
+		case 0x55: AddrMode_DirIdxX(); EOR<flags>(); break;
+		case 0x56: AddrMode_DirIdxX(); LSR<flags>(); break;
+		case 0x57: AddrMode_DirIndLngIdxY(); EOR<flags>(); break;
 		case 0x58: AddrMode_Imp(); CLI(); break;
-		case 0x59: AddrMode_AbsIdxY(false); EOR(); break;
-		case 0x5A: PHY(); break;
+		case 0x59: AddrMode_AbsIdxY<flags>(false); EOR<flags>(); break;
+		case 0x5A: PHY<flags>(); break;
 		case 0x5B: AddrMode_Imp(); TCD(); break;
 		case 0x5C: AddrMode_AbsLngJmp(); JML(); break;
-		case 0x5D: AddrMode_AbsIdxX(false); EOR(); break;
-		case 0x5E: AddrMode_AbsIdxX(true); LSR(); break;
-		case 0x5F: AddrMode_AbsLngIdxX(); EOR(); break;
+		case 0x5D: AddrMode_AbsIdxX<flags>(false); EOR<flags>(); break;
+		case 0x5E: AddrMode_AbsIdxX<flags>(true); LSR<flags>(); break;
+		case 0x5F: AddrMode_AbsLngIdxX(); EOR<flags>(); break;
 		case 0x60: RTS(); break;
-		case 0x61: AddrMode_DirIdxIndX(); ADC(); break;
+		case 0x61: AddrMode_DirIdxIndX(); ADC<flags>(); break;
 		case 0x62: AddrMode_RelLng(); PER(); break;
-		case 0x63: AddrMode_StkRel(); ADC(); break;
-		case 0x64: AddrMode_Dir(); STZ(); break;
-		case 0x65: AddrMode_Dir(); ADC(); break;
-		case 0x66: AddrMode_Dir(); ROR(); break;
-		case 0x67: AddrMode_DirIndLng(); ADC(); break;
-		case 0x68: PLA(); break;
-		case 0x69: AddrMode_ImmM(); ADC(); break;
-		case 0x6A: AddrMode_Acc(); ROR_Acc(); break;
+		case 0x63: AddrMode_StkRel(); ADC<flags>(); break;
+		case 0x64: AddrMode_Dir(); STZ<flags>(); break;
+		case 0x65: AddrMode_Dir(); ADC<flags>(); break;
+		case 0x66: AddrMode_Dir(); ROR<flags>(); break;
+		case 0x67: AddrMode_DirIndLng(); ADC<flags>(); break;
+		case 0x68: PLA<flags>(); break;
+		case 0x69: AddrMode_ImmM<flags>(); ADC<flags>(); break;
+		case 0x6A: AddrMode_Acc(); ROR_Acc<flags>(); break;
 		case 0x6B: RTL(); break;
 		case 0x6C: AddrMode_AbsInd(); JMP(); break;
-		case 0x6D: AddrMode_Abs(); ADC(); break;
-		case 0x6E: AddrMode_Abs(); ROR(); break;
-		case 0x6F: AddrMode_AbsLng(); ADC(); break;
+		case 0x6D: AddrMode_Abs(); ADC<flags>(); break;
+		case 0x6E: AddrMode_Abs(); ROR<flags>(); break;
+		case 0x6F: AddrMode_AbsLng(); ADC<flags>(); break;
 		case 0x70: AddrMode_Rel(); BVS(); break;
-		case 0x71: AddrMode_DirIndIdxY(false); ADC(); break;
-		case 0x72: AddrMode_DirInd(); ADC(); break;
-		case 0x73: AddrMode_StkRelIndIdxY(); ADC(); break;
-		case 0x74: AddrMode_DirIdxX(); STZ(); break;
-		case 0x75: AddrMode_DirIdxX(); ADC(); break;
-		case 0x76: AddrMode_DirIdxX(); ROR(); break;
-		case 0x77: AddrMode_DirIndLngIdxY(); ADC(); break;
+		case 0x71: AddrMode_DirIndIdxY<flags>(false); ADC<flags>(); break;
+		case 0x72: AddrMode_DirInd(); ADC<flags>(); break;
+		case 0x73: AddrMode_StkRelIndIdxY(); ADC<flags>(); break;
+		case 0x74: AddrMode_DirIdxX(); STZ<flags>(); break;
+		case 0x75: AddrMode_DirIdxX(); ADC<flags>(); break;
+		case 0x76: AddrMode_DirIdxX(); ROR<flags>(); break;
+		case 0x77: AddrMode_DirIndLngIdxY(); ADC<flags>(); break;
 		case 0x78: AddrMode_Imp(); SEI(); break;
-		case 0x79: AddrMode_AbsIdxY(false); ADC(); break;
-		case 0x7A: PLY(); break;
+		case 0x79: AddrMode_AbsIdxY<flags>(false); ADC<flags>(); break;
+		case 0x7A: PLY<flags>(); break;
 		case 0x7B: AddrMode_Imp(); TDC(); break;
 		case 0x7C: AddrMode_AbsIdxXInd(); JMP(); break;
-		case 0x7D: AddrMode_AbsIdxX(false); ADC(); break;
-		case 0x7E: AddrMode_AbsIdxX(true); ROR(); break;
-		case 0x7F: AddrMode_AbsLngIdxX(); ADC(); break;
+		case 0x7D: AddrMode_AbsIdxX<flags>(false); ADC<flags>(); break;
+		case 0x7E: AddrMode_AbsIdxX<flags>(true); ROR<flags>(); break;
+		case 0x7F: AddrMode_AbsLngIdxX(); ADC<flags>(); break;
 		case 0x80: AddrMode_Rel(); BRA(); break;
-		case 0x81: AddrMode_DirIdxIndX(); STA(); break;
+		case 0x81: AddrMode_DirIdxIndX(); STA<flags>(); break;
 		case 0x82: AddrMode_RelLng(); BRL(); break;
-		case 0x83: AddrMode_StkRel(); STA(); break;
-		case 0x84: AddrMode_Dir(); STY(); break;
-		case 0x85: AddrMode_Dir(); STA(); break;
-		case 0x86: AddrMode_Dir(); STX(); break;
-		case 0x87: AddrMode_DirIndLng(); STA(); break;
-		case 0x88: AddrMode_Imp(); DEY(); break;
-		case 0x89: AddrMode_ImmM(); BIT(); break;
-		case 0x8A: AddrMode_Imp(); TXA(); break;
+		case 0x83: AddrMode_StkRel(); STA<flags>(); break;
+		case 0x84: AddrMode_Dir(); STY<flags>(); break;
+		case 0x85: AddrMode_Dir(); STA<flags>(); break;
+		case 0x86: AddrMode_Dir(); STX<flags>(); break;
+		case 0x87: AddrMode_DirIndLng(); STA<flags>(); break;
+		case 0x88: AddrMode_Imp(); DEY<flags>(); break;
+		case 0x89: AddrMode_ImmM<flags>(); BIT<flags>(); break;
+		case 0x8A: AddrMode_Imp(); TXA<flags>(); break;
 		case 0x8B: PHB(); break;
-		case 0x8C: AddrMode_Abs(); STY(); break;
-		case 0x8D: AddrMode_Abs(); STA(); break;
-		case 0x8E: AddrMode_Abs(); STX(); break;
-		case 0x8F: AddrMode_AbsLng(); STA(); break;
+		case 0x8C: AddrMode_Abs(); STY<flags>(); break;
+		case 0x8D: AddrMode_Abs(); STA<flags>(); break;
+		case 0x8E: AddrMode_Abs(); STX<flags>(); break;
+		case 0x8F: AddrMode_AbsLng(); STA<flags>(); break;
 		case 0x90: AddrMode_Rel(); BCC(); break;
-		case 0x91: AddrMode_DirIndIdxY(true); STA(); break;
-		case 0x92: AddrMode_DirInd(); STA(); break;
-		case 0x93: AddrMode_StkRelIndIdxY(); STA(); break;
-		case 0x94: AddrMode_DirIdxX(); STY(); break;
-		case 0x95: AddrMode_DirIdxX(); STA(); break;
-		case 0x96: AddrMode_DirIdxY(); STX(); break;
-		case 0x97: AddrMode_DirIndLngIdxY(); STA(); break;
-		case 0x98: AddrMode_Imp(); TYA(); break;
-		case 0x99: AddrMode_AbsIdxY(true); STA(); break;
+		case 0x91: AddrMode_DirIndIdxY<flags>(true); STA<flags>(); break;
+		case 0x92: AddrMode_DirInd(); STA<flags>(); break;
+		case 0x93: AddrMode_StkRelIndIdxY(); STA<flags>(); break;
+		case 0x94: AddrMode_DirIdxX(); STY<flags>(); break;
+		case 0x95: AddrMode_DirIdxX(); STA<flags>(); break;
+		case 0x96: AddrMode_DirIdxY(); STX<flags>(); break;
+		case 0x97: AddrMode_DirIndLngIdxY(); STA<flags>(); break;
+		case 0x98: AddrMode_Imp(); TYA<flags>(); break;
+		case 0x99: AddrMode_AbsIdxY<flags>(true); STA<flags>(); break;
 		case 0x9A: AddrMode_Imp(); TXS(); break;
-		case 0x9B: AddrMode_Imp(); TXY(); break;
-		case 0x9C: AddrMode_Abs(); STZ(); break;
-		case 0x9D: AddrMode_AbsIdxX(true); STA(); break;
-		case 0x9E: AddrMode_AbsIdxX(true); STZ(); break;
-		case 0x9F: AddrMode_AbsLngIdxX(); STA(); break;
-		case 0xA0: AddrMode_ImmX(); LDY(); break;
-		case 0xA1: AddrMode_DirIdxIndX(); LDA(); break;
-		case 0xA2: AddrMode_ImmX(); LDX(); break;
-		case 0xA3: AddrMode_StkRel(); LDA(); break;
-		case 0xA4: AddrMode_Dir(); LDY(); break;
-		case 0xA5: AddrMode_Dir(); LDA(); break;
-		case 0xA6: AddrMode_Dir(); LDX(); break;
-		case 0xA7: AddrMode_DirIndLng(); LDA(); break;
-		case 0xA8: AddrMode_Imp(); TAY(); break;
-		case 0xA9: AddrMode_ImmM(); LDA(); break;
-		case 0xAA: AddrMode_Imp(); TAX(); break;
+		case 0x9B: AddrMode_Imp(); TXY<flags>(); break;
+		case 0x9C: AddrMode_Abs(); STZ<flags>(); break;
+		case 0x9D: AddrMode_AbsIdxX<flags>(true); STA<flags>(); break;
+		case 0x9E: AddrMode_AbsIdxX<flags>(true); STZ<flags>(); break;
+		case 0x9F: AddrMode_AbsLngIdxX(); STA<flags>(); break;
+		case 0xA0: AddrMode_ImmX<flags>(); LDY<flags>(); break;
+		case 0xA1: AddrMode_DirIdxIndX(); LDA<flags>(); break;
+		case 0xA2: AddrMode_ImmX<flags>(); LDX<flags>(); break;
+		case 0xA3: AddrMode_StkRel(); LDA<flags>(); break;
+		case 0xA4: AddrMode_Dir(); LDY<flags>(); break;
+		case 0xA5: AddrMode_Dir(); LDA<flags>(); break;
+		case 0xA6: AddrMode_Dir(); LDX<flags>(); break;
+		case 0xA7: AddrMode_DirIndLng(); LDA<flags>(); break;
+		case 0xA8: AddrMode_Imp(); TAY<flags>(); break;
+		case 0xA9: AddrMode_ImmM<flags>(); LDA<flags>(); break;
+		case 0xAA: AddrMode_Imp(); TAX<flags>(); break;
 		case 0xAB: PLB(); break;
-		case 0xAC: AddrMode_Abs(); LDY(); break;
-		case 0xAD: AddrMode_Abs(); LDA(); break;
-		case 0xAE: AddrMode_Abs(); LDX(); break;
-		case 0xAF: AddrMode_AbsLng(); LDA(); break;
+		case 0xAC: AddrMode_Abs(); LDY<flags>(); break;
+		case 0xAD: AddrMode_Abs(); LDA<flags>(); break;
+		case 0xAE: AddrMode_Abs(); LDX<flags>(); break;
+		case 0xAF: AddrMode_AbsLng(); LDA<flags>(); break;
 		case 0xB0: AddrMode_Rel(); BCS(); break;
-		case 0xB1: AddrMode_DirIndIdxY(false); LDA(); break;
-		case 0xB2: AddrMode_DirInd(); LDA(); break;
-		case 0xB3: AddrMode_StkRelIndIdxY(); LDA(); break;
-		case 0xB4: AddrMode_DirIdxX(); LDY(); break;
-		case 0xB5: AddrMode_DirIdxX(); LDA(); break;
-		case 0xB6: AddrMode_DirIdxY(); LDX(); break;
-		case 0xB7: AddrMode_DirIndLngIdxY(); LDA(); break;
+		case 0xB1: AddrMode_DirIndIdxY<flags>(false); LDA<flags>(); break;
+		case 0xB2: AddrMode_DirInd(); LDA<flags>(); break;
+		case 0xB3: AddrMode_StkRelIndIdxY(); LDA<flags>(); break;
+		case 0xB4: AddrMode_DirIdxX(); LDY<flags>(); break;
+		case 0xB5: AddrMode_DirIdxX(); LDA<flags>(); break;
+		case 0xB6: AddrMode_DirIdxY(); LDX<flags>(); break;
+		case 0xB7: AddrMode_DirIndLngIdxY(); LDA<flags>(); break;
 		case 0xB8: AddrMode_Imp(); CLV(); break;
-		case 0xB9: AddrMode_AbsIdxY(false); LDA(); break;
-		case 0xBA: AddrMode_Imp(); TSX(); break;
-		case 0xBB: AddrMode_Imp(); TYX(); break;
-		case 0xBC: AddrMode_AbsIdxX(false); LDY(); break;
-		case 0xBD: AddrMode_AbsIdxX(false); LDA(); break;
-		case 0xBE: AddrMode_AbsIdxY(false); LDX(); break;
-		case 0xBF: AddrMode_AbsLngIdxX(); LDA(); break;
-		case 0xC0: AddrMode_ImmX(); CPY(); break;
-		case 0xC1: AddrMode_DirIdxIndX(); CMP(); break;
+		case 0xB9: AddrMode_AbsIdxY<flags>(false); LDA<flags>(); break;
+		case 0xBA: AddrMode_Imp(); TSX<flags>(); break;
+		case 0xBB: AddrMode_Imp(); TYX<flags>(); break;
+		case 0xBC: AddrMode_AbsIdxX<flags>(false); LDY<flags>(); break;
+		case 0xBD: AddrMode_AbsIdxX<flags>(false); LDA<flags>(); break;
+		case 0xBE: AddrMode_AbsIdxY<flags>(false); LDX<flags>(); break;
+		case 0xBF: AddrMode_AbsLngIdxX(); LDA<flags>(); break;
+		case 0xC0: AddrMode_ImmX<flags>(); CPY<flags>(); break;
+		case 0xC1: AddrMode_DirIdxIndX(); CMP<flags>(); break;
 		case 0xC2: AddrMode_Imm8(); REP(); break;
-		case 0xC3: AddrMode_StkRel(); CMP(); break;
-		case 0xC4: AddrMode_Dir(); CPY(); break;
-		case 0xC5: AddrMode_Dir(); CMP(); break;
-		case 0xC6: AddrMode_Dir(); DEC(); break;
-		case 0xC7: AddrMode_DirIndLng(); CMP(); break;
-		case 0xC8: AddrMode_Imp(); INY(); break;
-		case 0xC9: AddrMode_ImmM(); CMP(); break;
-		case 0xCA: AddrMode_Imp(); DEX(); break;
+		case 0xC3: AddrMode_StkRel(); CMP<flags>(); break;
+		case 0xC4: AddrMode_Dir(); CPY<flags>(); break;
+		case 0xC5: AddrMode_Dir(); CMP<flags>(); break;
+		case 0xC6: AddrMode_Dir(); DEC<flags>(); break;
+		case 0xC7: AddrMode_DirIndLng(); CMP<flags>(); break;
+		case 0xC8: AddrMode_Imp(); INY<flags>(); break;
+		case 0xC9: AddrMode_ImmM<flags>(); CMP<flags>(); break;
+		case 0xCA: AddrMode_Imp(); DEX<flags>(); break;
 		case 0xCB: AddrMode_Imp(); WAI(); break;
-		case 0xCC: AddrMode_Abs(); CPY(); break;
-		case 0xCD: AddrMode_Abs(); CMP(); break;
-		case 0xCE: AddrMode_Abs(); DEC(); break;
-		case 0xCF: AddrMode_AbsLng(); CMP(); break;
+		case 0xCC: AddrMode_Abs(); CPY<flags>(); break;
+		case 0xCD: AddrMode_Abs(); CMP<flags>(); break;
+		case 0xCE: AddrMode_Abs(); DEC<flags>(); break;
+		case 0xCF: AddrMode_AbsLng(); CMP<flags>(); break;
 		case 0xD0: AddrMode_Rel(); BNE(); break;
-		case 0xD1: AddrMode_DirIndIdxY(false); CMP(); break;
-		case 0xD2: AddrMode_DirInd(); CMP(); break;
-		case 0xD3: AddrMode_StkRelIndIdxY(); CMP(); break;
+		case 0xD1: AddrMode_DirIndIdxY<flags>(false); CMP<flags>(); break;
+		case 0xD2: AddrMode_DirInd(); CMP<flags>(); break;
+		case 0xD3: AddrMode_StkRelIndIdxY(); CMP<flags>(); break;
 		case 0xD4: AddrMode_Dir(); PEI(); break;
-		case 0xD5: AddrMode_DirIdxX(); CMP(); break;
-		case 0xD6: AddrMode_DirIdxX(); DEC(); break;
-		case 0xD7: AddrMode_DirIndLngIdxY(); CMP(); break;
+		case 0xD5: AddrMode_DirIdxX(); CMP<flags>(); break;
+		case 0xD6: AddrMode_DirIdxX(); DEC<flags>(); break;
+		case 0xD7: AddrMode_DirIndLngIdxY(); CMP<flags>(); break;
 		case 0xD8: AddrMode_Imp(); CLD(); break;
-		case 0xD9: AddrMode_AbsIdxY(false); CMP(); break;
-		case 0xDA: PHX(); break;
+		case 0xD9: AddrMode_AbsIdxY<flags>(false); CMP<flags>(); break;
+		case 0xDA: PHX<flags>(); break;
 		case 0xDB: AddrMode_Imp(); STP(); break;
 		case 0xDC: AddrMode_AbsIndLng(); JML(); break;
-		case 0xDD: AddrMode_AbsIdxX(false); CMP(); break;
-		case 0xDE: AddrMode_AbsIdxX(true); DEC(); break;
-		case 0xDF: AddrMode_AbsLngIdxX(); CMP(); break;
-		case 0xE0: AddrMode_ImmX(); CPX(); break;
-		case 0xE1: AddrMode_DirIdxIndX(); SBC(); break;
+		case 0xDD: AddrMode_AbsIdxX<flags>(false); CMP<flags>(); break;
+		case 0xDE: AddrMode_AbsIdxX<flags>(true); DEC<flags>(); break;
+		case 0xDF: AddrMode_AbsLngIdxX(); CMP<flags>(); break;
+		case 0xE0: AddrMode_ImmX<flags>(); CPX<flags>(); break;
+		case 0xE1: AddrMode_DirIdxIndX(); SBC<flags>(); break;
 		case 0xE2: AddrMode_Imm8(); SEP(); break;
-		case 0xE3: AddrMode_StkRel(); SBC(); break;
-		case 0xE4: AddrMode_Dir(); CPX(); break;
-		case 0xE5: AddrMode_Dir(); SBC(); break;
-		case 0xE6: AddrMode_Dir(); INC(); break;
-		case 0xE7: AddrMode_DirIndLng(); SBC(); break;
-		case 0xE8: AddrMode_Imp(); INX(); break;
-		case 0xE9: AddrMode_ImmM(); SBC(); break;
+		case 0xE3: AddrMode_StkRel(); SBC<flags>(); break;
+		case 0xE4: AddrMode_Dir(); CPX<flags>(); break;
+		case 0xE5: AddrMode_Dir(); SBC<flags>(); break;
+		case 0xE6: AddrMode_Dir(); INC<flags>(); break;
+		case 0xE7: AddrMode_DirIndLng(); SBC<flags>(); break;
+		case 0xE8: AddrMode_Imp(); INX<flags>(); break;
+		case 0xE9: AddrMode_ImmM<flags>(); SBC<flags>(); break;
 		case 0xEA: AddrMode_Imp(); NOP(); break;
 		case 0xEB: AddrMode_Imp(); XBA(); break;
-		case 0xEC: AddrMode_Abs(); CPX(); break;
-		case 0xED: AddrMode_Abs(); SBC(); break;
-		case 0xEE: AddrMode_Abs(); INC(); break;
-		case 0xEF: AddrMode_AbsLng(); SBC(); break;
+		case 0xEC: AddrMode_Abs(); CPX<flags>(); break;
+		case 0xED: AddrMode_Abs(); SBC<flags>(); break;
+		case 0xEE: AddrMode_Abs(); INC<flags>(); break;
+		case 0xEF: AddrMode_AbsLng(); SBC<flags>(); break;
 		case 0xF0: AddrMode_Rel(); BEQ(); break;
-		case 0xF1: AddrMode_DirIndIdxY(false); SBC(); break;
-		case 0xF2: AddrMode_DirInd(); SBC(); break;
-		case 0xF3: AddrMode_StkRelIndIdxY(); SBC(); break;
+		case 0xF1: AddrMode_DirIndIdxY<flags>(false); SBC<flags>(); break;
+		case 0xF2: AddrMode_DirInd(); SBC<flags>(); break;
+		case 0xF3: AddrMode_StkRelIndIdxY(); SBC<flags>(); break;
 		case 0xF4: AddrMode_Imm16(); PEA(); break;
-		case 0xF5: AddrMode_DirIdxX(); SBC(); break;
-		case 0xF6: AddrMode_DirIdxX(); INC(); break;
-		case 0xF7: AddrMode_DirIndLngIdxY(); SBC(); break;
+		case 0xF5: AddrMode_DirIdxX(); SBC<flags>(); break;
+		case 0xF6: AddrMode_DirIdxX(); INC<flags>(); break;
+		case 0xF7: AddrMode_DirIndLngIdxY(); SBC<flags>(); break;
 		case 0xF8: AddrMode_Imp(); SED(); break;
-		case 0xF9: AddrMode_AbsIdxY(false); SBC(); break;
-		case 0xFA: PLX(); break;
+		case 0xF9: AddrMode_AbsIdxY<flags>(false); SBC<flags>(); break;
+		case 0xFA: PLX<flags>(); break;
 		case 0xFB: AddrMode_Imp(); XCE(); break;
 		case 0xFC: AddrMode_AbsIdxXInd(); JSR(); break;
-		case 0xFD: AddrMode_AbsIdxX(false); SBC(); break;
-		case 0xFE: AddrMode_AbsIdxX(true); INC(); break;
-		case 0xFF: AddrMode_AbsLngIdxX(); SBC(); break;
+		case 0xFD: AddrMode_AbsIdxX<flags>(false); SBC<flags>(); break;
+		case 0xFE: AddrMode_AbsIdxX<flags>(true); INC<flags>(); break;
+		case 0xFF: AddrMode_AbsLngIdxX(); SBC<flags>(); break;
+	}
+}
+
+void Cpu::RunOp()
+{
+	//Dispatch to the opcode table that matches the current M/X flags, so operand sizes are resolved at compile time
+	switch(_state.PS & (ProcFlags::MemoryMode8 | ProcFlags::IndexMode8)) {
+		case 0: RunOp<0>(); break;
+		case ProcFlags::IndexMode8: RunOp<ProcFlags::IndexMode8>(); break;
+		case ProcFlags::MemoryMode8: RunOp<ProcFlags::MemoryMode8>(); break;
+		default: RunOp<ProcFlags::MemoryMode8 | ProcFlags::IndexMode8>(); break;
 	}
 }
 
@@ -6,6 +6,8 @@
 #include "MemoryManager.h"
 #include "DmaController.h"
 #include "EventType.h"
+#include "EmuSettings.h"
+#include "BaseCartridge.h"
 #include "Cpu.Instructions.h"
 #include "Cpu.Shared.h"
 
@@ -26,6 +28,11 @@ void Cpu::Exec()
 {
 	_immediateMode = false;
 
+#ifndef DUMMYCPU
+	uint16_t prevPc = _state.PC;
+	uint8_t prevK = _state.K;
+#endif
+
 	switch(_state.StopState) {
 		case CpuStopState::Running: RunOp(); break;
 		case CpuStopState::Stopped:
@@ -38,6 +45,9 @@ void Cpu::Exec()
 		case CpuStopState::WaitingForIrq:
 			//WAI
 			Idle();
+		#ifndef DUMMYCPU
+			SyncCoprocessorIrq();
+		#endif
 			if(_state.IrqSource || _state.NeedNmi) {
 				Idle();
 				Idle();
@@ -47,6 +57,10 @@ void Cpu::Exec()
 	}
 
 #ifndef DUMMYCPU
+	if(!CheckFlag(ProcFlags::IrqDisable)) {
+		SyncCoprocessorIrq();
+	}
+
 	//Use the state of the IRQ/NMI flags on the previous cycle to determine if an IRQ is processed or not
 	if(_state.PrevNeedNmi) {
 		_state.NeedNmi = false;
@@ -58,6 +72,11 @@ void Cpu::Exec()
 		ProcessInterrupt(_state.EmulationMode ? Cpu::LegacyIrqVector : Cpu::IrqVector, true);
 		_console->ProcessInterrupt<CpuType::Cpu>(originalPc, GetProgramAddress(_state.PC), false);
 	}
+
+	if(_idleLoopSkipEnabled && _state.K == prevK && (uint16_t)(prevPc - _state.PC) <= Cpu::MaxIdleLoopSize) {
+		//Jumped back to the start of a short loop (or stayed on the same instruction, e.g WAI)
+		ProcessIdleLoop((_state.K << 16) | _state.PC);
+	}
 #endif
 }
 
@@ -102,6 +121,11 @@ uint16_t Cpu::GetResetVector()
 #ifndef DUMMYCPU
 uint8_t Cpu::Read(uint32_t addr, MemoryOperationType type)
 {
+	if(_idleLoopStable && !_memoryManager->GetMemoryMappings()->HasDirectReadPointer(addr)) {
+		//Registers and coprocessor-backed memory can change on their own, the loop may not be skipped
+		_idleLoopStable = false;
+	}
+
 	_memoryManager->SetCpuSpeed(_memoryManager->GetCpuSpeed(addr));
 	ProcessCpuCycle();
 	uint8_t value = _memoryManager->Read(addr, type);
@@ -111,9 +135,87 @@ uint8_t Cpu::Read(uint32_t addr, MemoryOperationType type)
 
 void Cpu::Write(uint32_t addr, uint8_t value, MemoryOperationType type)
 {
+	_idleLoopStable = false;
+
 	_memoryManager->SetCpuSpeed(_memoryManager->GetCpuSpeed(addr));
 	ProcessCpuCycle();
 	_memoryManager->Write(addr, value, type);
 	UpdateIrqNmiFlags();
 }
+
+void Cpu::ProcessIdleLoop(uint32_t loopAddr)
+{
+	//If the previous iteration of this loop did not write anything, only read plain RAM/ROM and ended in the same
+	//state it started in, every following iteration will do the exact same thing until something outside the CPU
+	//changes the memory or the IRQ/NMI lines. That can only happen on a scanline event, an IRQ counter match or
+	//a DMA transfer, so the iterations until the next one of those can be skipped by just advancing the clocks.
+	uint64_t masterClock = _memoryManager->GetMasterClock();
+	uint32_t eventCount = _memoryManager->GetEventCount();
+
+	if(_idleLoopStable && loopAddr == _idleLoopAddr && eventCount == _idleLoopEventCount && IsIdleLoopStateUnchanged()) {
+		uint16_t loopClocks = (uint16_t)(masterClock - _idleLoopMasterClock);
+		if(loopClocks > 0) {
+			uint32_t loopCount = _memoryManager->SkipIdleLoop(loopClocks);
+			if(loopCount > 0) {
+				uint64_t skippedCycles = loopCount * (_state.CycleCount - _idleLoopState.CycleCount);
+				_state.CycleCount += skippedCycles;
+				_idleCyclesSkipped += skippedCycles;
+				masterClock = _memoryManager->GetMasterClock();
+			}
+		}
+	}
+
+	//DMA/HDMA transfers that are already pending would run during the next iteration and make it longer
+	_idleLoopStable = !_dmaController->HasPendingTransfers();
+	_idleLoopAddr = loopAddr;
+	_idleLoopEventCount = eventCount;
+	_idleLoopMasterClock = masterClock;
+	_idleLoopState = _state;
+}
+
+bool Cpu::IsIdleLoopStateUnchanged()
+{
+	CpuState &prev = _idleLoopState;
+	return (
+		_state.A == prev.A && _state.X == prev.X && _state.Y == prev.Y && _state.SP == prev.SP && _state.D == prev.D &&
+		_state.PC == prev.PC && _state.K == prev.K && _state.DBR == prev.DBR && _state.PS == prev.PS &&
+		_state.EmulationMode == prev.EmulationMode && _state.NmiFlag == prev.NmiFlag && _state.PrevNmiFlag == prev.PrevNmiFlag &&
+		_state.IrqLock == prev.IrqLock && _state.PrevNeedNmi == prev.PrevNeedNmi && _state.NeedNmi == prev.NeedNmi &&
+		_state.IrqSource == prev.IrqSource && _state.PrevIrqSource == prev.PrevIrqSource && _state.StopState == prev.StopState
+	);
+}
+
+void Cpu::StartFrame()
+{
+	//Coprocessors that run in parallel with the CPU (SA-1, GSU, etc.) can change memory or trigger IRQs at any time
+	_idleLoopSkipEnabled = (
+		_console->GetSettings()->GetEmulationConfig().EnableIdleLoopSkipping &&
+		!_console->GetCartridge()->NeedsCoprocessorSync() &&
+		!_console->IsDebugging()
+	);
+	_idleLoopStable = false;
+	_cart = _console->GetCartridge()->NeedsCoprocessorSync() ? _console->GetCartridge().get() : nullptr;
+
+	_prevFrameIdleCyclesSkipped = _idleCyclesSkipped;
+	_idleCyclesSkipped = 0;
+}
+
+void Cpu::SyncCoprocessorIrq()
+{
+	if(_cart) {
+		//Catch up the coprocessor so an IRQ it raised/cleared since its last sync is seen on this instruction.
+		//The IRQ line was already sampled on the last cycle, refresh it if the coprocessor changed it.
+		uint8_t irqSource = _state.IrqSource;
+		_cart->SyncCoprocessorIrq();
+		if(_state.IrqSource != irqSource) {
+			_state.PrevIrqSource = _state.IrqSource && !CheckFlag(ProcFlags::IrqDisable);
+		}
+	}
+}
+
+uint64_t Cpu::GetSkippedIdleCycles()
+{
+	//Number of CPU cycles that were skipped by idle loop detection during the last frame
+	return _prevFrameIdleCyclesSkipped;
+}
 #endif
@@ -13,6 +13,7 @@ class MemoryMappings;
 class MemoryManager;
 class DmaController;
 class Console;
+class BaseCartridge;
 
 class Cpu : public ISerializable
 {
@@ -103,11 +104,11 @@ private:
 	//Add/substract instructions
 	void Add8(uint8_t value);
 	void Add16(uint16_t value);
-	void ADC();
+	template<uint8_t flags> void ADC();
 
 	void Sub8(uint8_t value);
 	void Sub16(uint16_t value);
-	void SBC();
+	template<uint8_t flags> void SBC();
 	
 	//Branch instructions
 	void BCC();
@@ -135,24 +136,24 @@ private:
 	void SEP();
 
 	//Increment/decrement instructions
-	void DEX();
-	void DEY();
-	void INX();
-	void INY();
-	void DEC();
-	void INC();
+	template<uint8_t flags> void DEX();
+	template<uint8_t flags> void DEY();
+	template<uint8_t flags> void INX();
+	template<uint8_t flags> void INY();
+	template<uint8_t flags> void DEC();
+	template<uint8_t flags> void INC();
 
-	void DEC_Acc();
-	void INC_Acc();
+	template<uint8_t flags> void DEC_Acc();
+	template<uint8_t flags> void INC_Acc();
 
-	void IncDecReg(uint16_t & reg, int8_t offset);
-	void IncDec(int8_t offset);
+	template<uint8_t flags> void IncDecReg(uint16_t & reg, int8_t offset);
+	template<uint8_t flags> void IncDec(int8_t offset);
 
 	//Compare instructions
 	void Compare(uint16_t reg, bool eightBitMode);
-	void CMP();
-	void CPX();
-	void CPY();
+	template<uint8_t flags> void CMP();
+	template<uint8_t flags> void CPX();
+	template<uint8_t flags> void CPY();
 
 	//Jump instructions
 	void JML();
@@ -169,9 +170,9 @@ private:
 	void COP();
 
 	//Bitwise operations
-	void AND();
-	void EOR();
-	void ORA();
+	template<uint8_t flags> void AND();
+	template<uint8_t flags> void EOR();
+	template<uint8_t flags> void ORA();
 
 	template<typename T> T ShiftLeft(T value);
 	template<typename T> T RollLeft(T value);
@@ -179,18 +180,18 @@ private:
 	template<typename T> T RollRight(T value);
 
 	//Shift operations
-	void ASL_Acc();
-	void ASL();
-	void LSR_Acc();
-	void LSR();
-	void ROL_Acc();
-	void ROL();
-	void ROR_Acc();
-	void ROR();
+	template<uint8_t flags> void ASL_Acc();
+	template<uint8_t flags> void ASL();
+	template<uint8_t flags> void LSR_Acc();
+	template<uint8_t flags> void LSR();
+	template<uint8_t flags> void ROL_Acc();
+	template<uint8_t flags> void ROL();
+	template<uint8_t flags> void ROR_Acc();
+	template<uint8_t flags> void ROR();
 
 	//Move operations
-	void MVN();
-	void MVP();
+	template<uint8_t flags> void MVN();
+	template<uint8_t flags> void MVP();
 
 	//Push/pull instructions
 	void PEA();
@@ -204,12 +205,12 @@ private:
 	void PLD();
 	void PLP();
 
-	void PHA();
-	void PHX();
-	void PHY();
-	void PLA();
-	void PLX();
-	void PLY();
+	template<uint8_t flags> void PHA();
+	template<uint8_t flags> void PHX();
+	template<uint8_t flags> void PHY();
+	template<uint8_t flags> void PLA();
+	template<uint8_t flags> void PLX();
+	template<uint8_t flags> void PLY();
 
 	void PushRegister(uint16_t reg, bool eightBitMode);
 	void PullRegister(uint16_t &reg, bool eightBitMode);
@@ -218,35 +219,35 @@ private:
 	void LoadRegister(uint16_t &reg, bool eightBitMode);
 	void StoreRegister(uint16_t val, bool eightBitMode);
 
-	void LDA();
-	void LDX();
-	void LDY();
+	template<uint8_t flags> void LDA();
+	template<uint8_t flags> void LDX();
+	template<uint8_t flags> void LDY();
 
-	void STA();
-	void STX();
-	void STY();
-	void STZ();
+	template<uint8_t flags> void STA();
+	template<uint8_t flags> void STX();
+	template<uint8_t flags> void STY();
+	template<uint8_t flags> void STZ();
 		
 	//Test bits
 	template<typename T> void TestBits(T value, bool alterZeroFlagOnly);
-	void BIT();
+	template<uint8_t flags> void BIT();
 
-	void TRB();
-	void TSB();
+	template<uint8_t flags> void TRB();
+	template<uint8_t flags> void TSB();
 
 	//Transfer registers
-	void TAX();
-	void TAY();
+	template<uint8_t flags> void TAX();
+	template<uint8_t flags> void TAY();
 	void TCD();
 	void TCS();
 	void TDC();
 	void TSC();
-	void TSX();
-	void TXA();
+	template<uint8_t flags> void TSX();
+	template<uint8_t flags> void TXA();
 	void TXS();
-	void TXY();
-	void TYA();
-	void TYX();
+	template<uint8_t flags> void TXY();
+	template<uint8_t flags> void TYA();
+	template<uint8_t flags> void TYX();
 	void XBA();
 	void XCE();
 
@@ -262,9 +263,9 @@ private:
 	//Absolute: a
 	void AddrMode_Abs();
 	//Absolute Indexed: a,x
-	void AddrMode_AbsIdxX(bool isWrite);
+	template<uint8_t flags> void AddrMode_AbsIdxX(bool isWrite);
 	//Absolute Indexed: a,y
-	void AddrMode_AbsIdxY(bool isWrite);
+	template<uint8_t flags> void AddrMode_AbsIdxY(bool isWrite);
 	//Absolute Long: al
 	void AddrMode_AbsLng();
 	//Absolute Long Indexed: al,x
@@ -294,7 +295,7 @@ private:
 	//Direct Indexed Indirect: (d,x)
 	void AddrMode_DirIdxIndX();
 	//Direct Indirect Indexed: (d),y
-	void AddrMode_DirIndIdxY(bool isWrite);
+	template<uint8_t flags> void AddrMode_DirIndIdxY(bool isWrite);
 	//Direct Indirect Long: [d]
 	void AddrMode_DirIndLng();
 	//Direct Indirect Indexed Long: [d],y
@@ -302,8 +303,8 @@ private:
 
 	void AddrMode_Imm8();
 	void AddrMode_Imm16();
-	void AddrMode_ImmX();
-	void AddrMode_ImmM();
+	template<uint8_t flags> void AddrMode_ImmX();
+	template<uint8_t flags> void AddrMode_ImmM();
 
 	void AddrMode_Imp();
 
@@ -313,8 +314,31 @@ private:
 	void AddrMode_StkRel();
 	void AddrMode_StkRelIndIdxY();
 	
+	template<uint8_t flags> void RunOp();
 	void RunOp();
 
+#ifndef DUMMYCPU
+	//Idle loop skipping
+	static constexpr uint16_t MaxIdleLoopSize = 32;
+
+	bool _idleLoopSkipEnabled = false;
+	bool _idleLoopStable = false;
+	uint32_t _idleLoopAddr = 0;
+	uint32_t _idleLoopEventCount = 0;
+	uint64_t _idleLoopMasterClock = 0;
+	CpuState _idleLoopState = {};
+	uint64_t _idleCyclesSkipped = 0;
+	uint64_t _prevFrameIdleCyclesSkipped = 0;
+
+	//Coprocessor that raises IRQs and may lag behind the CPU by up to a sync quantum
+	BaseCartridge* _cart = nullptr;
+
+	void SyncCoprocessorIrq();
+
+	void ProcessIdleLoop(uint32_t loopAddr);
+	bool IsIdleLoopStateUnchanged();
+#endif
+
 public:
 #ifndef DUMMYCPU
 	Cpu(Console *console);
@@ -345,6 +369,11 @@ public:
 	// Inherited via ISerializable
 	void Serialize(Serializer &s) override;
 
+#ifndef DUMMYCPU
+	void StartFrame();
+	uint64_t GetSkippedIdleCycles();
+#endif
+
 #ifdef DUMMYCPU
 private:
 	MemoryMappings* _memoryMappings;
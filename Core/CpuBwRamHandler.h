@@ -7,6 +7,7 @@
 
 //Manages BWRAM access from the SNES CPU
 //Returns conversion result when char conversion type 1 is enabled
+//Catches up the SA-1 before each access
 class CpuBwRamHandler : public IMemoryHandler
 {
 private:
@@ -14,6 +15,15 @@ private:
 	Sa1State* _state;
 	Sa1* _sa1;
 
+	__forceinline uint8_t InternalRead(uint32_t addr)
+	{
+		if(_state->CharConvDmaActive) {
+			return _sa1->ReadCharConvertType1(addr);
+		} else {
+			return _handler->Read(addr);
+		}
+	}
+
 public:
 	CpuBwRamHandler(IMemoryHandler* handler, Sa1State* state, Sa1* sa1) : IMemoryHandler(handler->GetMemoryType())
 	{
@@ -24,16 +34,13 @@ public:
 
 	uint8_t Read(uint32_t addr) override
 	{
-		if(_state->CharConvDmaActive) {
-			return _sa1->ReadCharConvertType1(addr);
-		} else {
-			return _handler->Read(addr);
-		}
+		_sa1->Run();
+		return InternalRead(addr);
 	}
 
 	uint8_t Peek(uint32_t addr) override
 	{
-		return Read(addr);
+		return InternalRead(addr);
 	}
 
 	void PeekBlock(uint32_t addr, uint8_t *output) override
@@ -43,6 +50,7 @@ public:
 
 	void Write(uint32_t addr, uint8_t value) override
 	{
+		_sa1->Run();
 		_handler->Write(addr, value);
 	}
 
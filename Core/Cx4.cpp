@@ -7,6 +7,7 @@
 #include "BaseCartridge.h"
 #include "EmuSettings.h"
 #include "RamHandler.h"
+#include "CoprocessorSyncHandler.h"
 #include "../Utilities/HexUtilities.h"
 
 //TODO: Proper open bus behavior (and return 0s for missing save ram, too)
@@ -33,15 +34,19 @@ Cx4::Cx4(Console* console) : BaseCoprocessor(SnesMemoryType::Register)
 	_mappings.RegisterHandler(0x00, bankCount, 0x8000, 0xFFFF, prgRomHandlers);
 	_mappings.RegisterHandler(0x80, 0x80 + bankCount, 0x8000, 0xFFFF, prgRomHandlers);
 
-	//Save RAM
-	cpuMappings->RegisterHandler(0x70, 0x7D, 0x0000, 0x7FFF, saveRamHandlers);
-	cpuMappings->RegisterHandler(0xF0, 0xFF, 0x0000, 0x7FFF, saveRamHandlers);
+	//Save RAM (the CPU catches up the CX4 before accessing it)
+	for(unique_ptr<IMemoryHandler> &handler : saveRamHandlers) {
+		_cpuSaveRamHandlers.push_back(unique_ptr<IMemoryHandler>(new CoprocessorSyncHandler(handler.get(), this)));
+	}
+	cpuMappings->RegisterHandler(0x70, 0x7D, 0x0000, 0x7FFF, _cpuSaveRamHandlers);
+	cpuMappings->RegisterHandler(0xF0, 0xFF, 0x0000, 0x7FFF, _cpuSaveRamHandlers);
 	_mappings.RegisterHandler(0x70, 0x7D, 0x0000, 0x7FFF, saveRamHandlers);
 	_mappings.RegisterHandler(0xF0, 0xFF, 0x0000, 0x7FFF, saveRamHandlers);
 
 	//Registers
-	cpuMappings->RegisterHandler(0x00, 0x3F, 0x6000, 0x7FFF, this);
-	cpuMappings->RegisterHandler(0x80, 0xBF, 0x6000, 0x7FFF, this);
+	_cpuRegisterHandler.reset(new CoprocessorSyncHandler(this, this));
+	cpuMappings->RegisterHandler(0x00, 0x3F, 0x6000, 0x7FFF, _cpuRegisterHandler.get());
+	cpuMappings->RegisterHandler(0x80, 0xBF, 0x6000, 0x7FFF, _cpuRegisterHandler.get());
 	_mappings.RegisterHandler(0x00, 0x3F, 0x6000, 0x7FFF, this);
 	_mappings.RegisterHandler(0x80, 0xBF, 0x6000, 0x7FFF, this);
 
@@ -258,7 +263,10 @@ uint8_t Cx4::ReadCx4(uint32_t addr)
 {
 	IMemoryHandler* handler = _mappings.GetHandler(addr);
 	if(handler) {
-		uint8_t value = handler->Read(addr);
+		uint8_t value;
+		if(!_mappings.TryRead(addr, value)) {
+			value = handler->Read(addr);
+		}
 		_console->ProcessMemoryRead<CpuType::Cx4>(addr, value, MemoryOperationType::Read);
 		return value;
 	}
@@ -270,7 +278,9 @@ void Cx4::WriteCx4(uint32_t addr, uint8_t value)
 	IMemoryHandler* handler = _mappings.GetHandler(addr);
 	if(handler) {
 		_console->ProcessMemoryWrite<CpuType::Cx4>(addr, value, MemoryOperationType::Write);
-		handler->Write(addr, value);
+		if(!_mappings.TryWrite(addr, value)) {
+			handler->Write(addr, value);
+		}
 	}
 }
 
@@ -19,6 +19,9 @@ private:
 	MemoryMappings _mappings;
 	double _clockRatio;
 
+	unique_ptr<IMemoryHandler> _cpuRegisterHandler;
+	vector<unique_ptr<IMemoryHandler>> _cpuSaveRamHandlers;
+
 	Cx4State _state;
 	uint16_t _prgRam[2][256];
 	uint8_t _dataRam[Cx4::DataRamSize];
@@ -33,6 +33,12 @@ void DebugHud::Draw(uint32_t* argbBuffer, OverscanDimensions overscan, uint32_t
 	_commands.erase(std::remove_if(_commands.begin(), _commands.end(), [](const unique_ptr<DrawCommand>& c) { return c->Expired(); }), _commands.end());
 }
 
+bool DebugHud::HasCommands()
+{
+	auto lock = _commandLock.AcquireSafe();
+	return !_commands.empty();
+}
+
 void DebugHud::DrawPixel(int x, int y, int color, int frameCount, int startFrame)
 {
 	auto lock = _commandLock.AcquireSafe();
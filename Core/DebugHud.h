@@ -17,6 +17,7 @@ public:
 	~DebugHud();
 
 	void Draw(uint32_t* argbBuffer, OverscanDimensions overscan, uint32_t width, uint32_t frameNumber);
+	bool HasCommands();
 	void ClearScreen();
 
 	void DrawPixel(int x, int y, int color, int frameCount, int startFrame);
@@ -6,12 +6,89 @@
 #include "EmuSettings.h"
 #include "SettingTypes.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define VIDEO_FILTER_USE_SSE2
+
+	#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+		//AVX2 kernels are compiled with the target attribute and only used when the CPU supports them
+		#include <immintrin.h>
+		#define VIDEO_FILTER_USE_AVX2
+	#endif
+#endif
+
 const static double PI = 3.14159265358979323846;
 
+#ifdef VIDEO_FILTER_USE_SSE2
+//8 RGB555 colors to ARGB (same result as DefaultVideoFilter::ToArgb)
+static __forceinline void ConvertRgb555(__m128i colors, __m128i &argbLow, __m128i &argbHigh)
+{
+	__m128i mask = _mm_set1_epi16(0x1F);
+	__m128i r = _mm_and_si128(colors, mask);
+	__m128i g = _mm_and_si128(_mm_srli_epi16(colors, 5), mask);
+	__m128i b = _mm_and_si128(_mm_srli_epi16(colors, 10), mask);
+	r = _mm_or_si128(_mm_slli_epi16(r, 3), _mm_srli_epi16(r, 2));
+	g = _mm_or_si128(_mm_slli_epi16(g, 3), _mm_srli_epi16(g, 2));
+	b = _mm_or_si128(_mm_slli_epi16(b, 3), _mm_srli_epi16(b, 2));
+
+	__m128i gb = _mm_or_si128(_mm_slli_epi16(g, 8), b);
+	__m128i ar = _mm_or_si128(r, _mm_set1_epi16((int16_t)0xFF00));
+	argbLow = _mm_unpacklo_epi16(gb, ar);
+	argbHigh = _mm_unpackhi_epi16(gb, ar);
+}
+
+//Same as DefaultVideoFilter::BlendPixels, for 4 pixels
+static __forceinline __m128i BlendArgb(__m128i a, __m128i b)
+{
+	__m128i diff = _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi32((int32_t)0xFFFEFEFE));
+	return _mm_add_epi32(_mm_srli_epi32(diff, 1), _mm_and_si128(a, b));
+}
+#endif
+
+#ifdef VIDEO_FILTER_USE_AVX2
+__attribute__((target("avx2"))) static __forceinline __m256i ConvertRgb555Avx2(__m128i colors, const uint32_t *palette)
+{
+	__m256i indexes = _mm256_cvtepu16_epi32(colors);
+	if(palette) {
+		return _mm256_i32gather_epi32((const int*)palette, indexes, 4);
+	}
+
+	__m256i mask = _mm256_set1_epi32(0x1F);
+	__m256i r = _mm256_and_si256(indexes, mask);
+	__m256i g = _mm256_and_si256(_mm256_srli_epi32(indexes, 5), mask);
+	__m256i b = _mm256_and_si256(_mm256_srli_epi32(indexes, 10), mask);
+	r = _mm256_or_si256(_mm256_slli_epi32(r, 3), _mm256_srli_epi32(r, 2));
+	g = _mm256_or_si256(_mm256_slli_epi32(g, 3), _mm256_srli_epi32(g, 2));
+	b = _mm256_or_si256(_mm256_slli_epi32(b, 3), _mm256_srli_epi32(b, 2));
+	return _mm256_or_si256(_mm256_or_si256(_mm256_set1_epi32((int32_t)0xFF000000), _mm256_slli_epi32(r, 16)), _mm256_or_si256(_mm256_slli_epi32(g, 8), b));
+}
+
+//Converts 8 pixels at a time, with the palette (gathered) or with the direct conversion when palette is null
+//Returns the number of pixels converted
+__attribute__((target("avx2"))) static uint32_t DecodeRowAvx2(uint32_t *out, const uint16_t *in, const uint16_t *prevIn, uint32_t count, const uint32_t *palette)
+{
+	uint32_t i = 0;
+	for(; i + 8 <= count; i += 8) {
+		__m256i argb = ConvertRgb555Avx2(_mm_loadu_si128((const __m128i*)(in + i)), palette);
+		if(prevIn) {
+			__m256i prevArgb = ConvertRgb555Avx2(_mm_loadu_si128((const __m128i*)(prevIn + i)), palette);
+			__m256i diff = _mm256_and_si256(_mm256_xor_si256(prevArgb, argb), _mm256_set1_epi32((int32_t)0xFFFEFEFE));
+			argb = _mm256_add_epi32(_mm256_srli_epi32(diff, 1), _mm256_and_si256(prevArgb, argb));
+		}
+		_mm256_storeu_si256((__m256i*)(out + i), argb);
+	}
+	return i;
+}
+#endif
+
 DefaultVideoFilter::DefaultVideoFilter(shared_ptr<Console> console) : BaseVideoFilter(console)
 {
 	InitLookupTable();
 	_prevFrame = new uint16_t[256 * 240];
+
+#ifdef VIDEO_FILTER_USE_AVX2
+	_useAvx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
 	memset(_prevFrame, 0, 256 * 240 * sizeof(uint16_t));
 }
 
@@ -79,6 +156,7 @@ void DefaultVideoFilter::InitLookupTable()
 		}
 	}
 
+	_directColors = !_gbcAdjustColors && config.Hue == 0 && config.Saturation == 0 && config.Brightness == 0 && config.Contrast == 0;
 	_videoConfig = config;
 }
 
@@ -114,6 +192,7 @@ uint32_t DefaultVideoFilter::ToArgb(uint16_t rgb555)
 void DefaultVideoFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 {
 	uint32_t *out = GetOutputBuffer();
+	uint32_t pitch = GetOutputPitch();
 	FrameInfo frameInfo = GetFrameInfo();
 	OverscanDimensions overscan = GetOverscan();
 	
@@ -123,25 +202,12 @@ void DefaultVideoFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 	uint32_t yOffset = overscan.Top * overscanMultiplier * width;
 
 	uint8_t scanlineIntensity = (uint8_t)((1.0 - _console->GetSettings()->GetVideoConfig().ScanlineIntensity) * 255);
-	if(scanlineIntensity < 255) {
-		for(uint32_t i = 0; i < frameInfo.Height; i++) {
-			if(i & 0x01) {
-				for(uint32_t j = 0; j < frameInfo.Width; j++) {
-					*out = ApplyScanlineEffect(GetPixel(ppuOutputBuffer, i * width + j + yOffset + xOffset), scanlineIntensity);
-					out++;
-				}
-			} else {
-				for(uint32_t j = 0; j < frameInfo.Width; j++) {
-					*out = GetPixel(ppuOutputBuffer, i * width + j + yOffset + xOffset);
-					out++;
-				}
-			}
-		}
-	} else {
-		for(uint32_t i = 0; i < frameInfo.Height; i++) {
-			for(uint32_t j = 0; j < frameInfo.Width; j++) {
-				out[i*frameInfo.Width+j] = GetPixel(ppuOutputBuffer, i * width + j + yOffset + xOffset);
-			}
+	for(uint32_t i = 0; i < frameInfo.Height; i++) {
+		uint32_t offset = i * width + yOffset + xOffset;
+		DecodeRow(out + i * pitch, ppuOutputBuffer + offset, _gbBlendFrames ? _prevFrame + offset : nullptr, frameInfo.Width);
+
+		if(scanlineIntensity < 255 && (i & 0x01)) {
+			ApplyScanlineEffect(out + i * pitch, frameInfo.Width, scanlineIntensity);
 		}
 	}
 
@@ -149,10 +215,10 @@ void DefaultVideoFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 		//Very basic blend effect for high resolution modes
 		for(uint32_t i = 0; i < frameInfo.Height; i+=2) {
 			for(uint32_t j = 0; j < frameInfo.Width; j+=2) {
-				uint32_t &pixel1 = out[i*frameInfo.Width + j];
-				uint32_t &pixel2 = out[i*frameInfo.Width + j + 1];
-				uint32_t &pixel3 = out[(i+1)*frameInfo.Width + j];
-				uint32_t &pixel4 = out[(i+1)*frameInfo.Width + j + 1];
+				uint32_t &pixel1 = out[i*pitch + j];
+				uint32_t &pixel2 = out[i*pitch + j + 1];
+				uint32_t &pixel3 = out[(i+1)*pitch + j];
+				uint32_t &pixel4 = out[(i+1)*pitch + j + 1];
 				pixel1 = pixel2 = pixel3 = pixel4 = BlendPixels(BlendPixels(BlendPixels(pixel1, pixel2), pixel3), pixel4);
 			}
 		}
@@ -163,12 +229,43 @@ void DefaultVideoFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 	}
 }
 
-uint32_t DefaultVideoFilter::GetPixel(uint16_t* ppuFrame, uint32_t offset)
+void DefaultVideoFilter::DecodeRow(uint32_t *out, const uint16_t *in, const uint16_t *prevIn, uint32_t count)
 {
-	if(_gbBlendFrames) {
-		return BlendPixels(_calculatedPalette[_prevFrame[offset]], _calculatedPalette[ppuFrame[offset]]);
+	//Converts a row of RGB555 pixels with the palette, blended with the previous frame's row when prevIn is set (GB frame blending)
+	uint32_t i = 0;
+
+#ifdef VIDEO_FILTER_USE_AVX2
+	if(_useAvx2) {
+		i = DecodeRowAvx2(out, in, prevIn, count, _directColors ? nullptr : _calculatedPalette);
+	}
+#endif
+
+#ifdef VIDEO_FILTER_USE_SSE2
+	if(_directColors) {
+		//Without AVX2, the palette is only skipped when it matches the direct conversion (SSE2 has no gather instruction)
+		for(; i + 8 <= count; i += 8) {
+			__m128i argbLow, argbHigh;
+			ConvertRgb555(_mm_loadu_si128((const __m128i*)(in + i)), argbLow, argbHigh);
+			if(prevIn) {
+				__m128i prevLow, prevHigh;
+				ConvertRgb555(_mm_loadu_si128((const __m128i*)(prevIn + i)), prevLow, prevHigh);
+				argbLow = BlendArgb(prevLow, argbLow);
+				argbHigh = BlendArgb(prevHigh, argbHigh);
+			}
+			_mm_storeu_si128((__m128i*)(out + i), argbLow);
+			_mm_storeu_si128((__m128i*)(out + i + 4), argbHigh);
+		}
+	}
+#endif
+
+	if(prevIn) {
+		for(; i < count; i++) {
+			out[i] = BlendPixels(_calculatedPalette[prevIn[i]], _calculatedPalette[in[i]]);
+		}
 	} else {
-		return _calculatedPalette[ppuFrame[offset]];
+		for(; i < count; i++) {
+			out[i] = _calculatedPalette[in[i]];
+		}
 	}
 }
 
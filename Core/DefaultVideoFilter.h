@@ -6,6 +6,8 @@
 
 class DefaultVideoFilter : public BaseVideoFilter
 {
+	friend class VideoFilterBench; //Libretro/VideoFilterBench
+
 private:
 	uint32_t _calculatedPalette[0x8000] = {};
 	double _yiqToRgbMatrix[6] = {};
@@ -15,6 +17,10 @@ private:
 	bool _gbBlendFrames = false;
 	bool _gbcAdjustColors = false;
 
+	//True when _calculatedPalette is a plain conversion of each RGB555 color to 8 bits per channel (no color adjustments)
+	bool _directColors = false;
+	bool _useAvx2 = false;
+
 	void InitConversionMatrix(double hueShift, double saturationShift);
 	void InitLookupTable();
 
@@ -22,7 +28,7 @@ private:
 	void YiqToRgb(double y, double i, double q, double &r, double &g, double &b);
 	__forceinline static uint8_t To8Bit(uint8_t color);
 	__forceinline static uint32_t BlendPixels(uint32_t a, uint32_t b);
-	__forceinline uint32_t GetPixel(uint16_t* ppuFrame, uint32_t offset);
+	void DecodeRow(uint32_t *out, const uint16_t *in, const uint16_t *prevIn, uint32_t count);
 
 protected:
 	void OnBeforeApplyFilter();
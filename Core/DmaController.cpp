@@ -74,6 +74,13 @@ void DmaController::RunDma(DmaChannelConfig &channel)
 
 	uint8_t i = 0;
 	do {
+		uint16_t blockLength = RunDmaBlock(channel, i);
+		if(blockLength > 0) {
+			i += blockLength;
+			ProcessPendingTransfers();
+			continue;
+		}
+
 		//Manual DMA transfers run to the end of the transfer when started
 		CopyDmaByte(
 			(channel.SrcBank << 16) | channel.SrcAddress,
@@ -93,6 +100,43 @@ void DmaController::RunDma(DmaChannelConfig &channel)
 	channel.DmaActive = false;
 }
 
+uint16_t DmaController::RunDmaBlock(DmaChannelConfig &channel, uint8_t offsetIndex)
+{
+	//Fast path for the common WRAM/ROM -> VRAM/CGRAM/OAM transfers: when no HDMA transfer, event or IRQ can occur
+	//before the end of the block, and the PPU isn't rendering, copy as many bytes as possible in one go.
+	//Returns 0 when the transfer must instead be done one byte at a time, via CopyDmaByte
+	if(channel.InvertDirection || _hdmaPending || _hdmaInitPending) {
+		return 0;
+	}
+
+	const uint8_t *transferOffsets = _transferOffset[channel.TransferMode];
+	for(int i = 0; i < 4; i++) {
+		switch((uint8_t)(channel.DestAddress + transferOffsets[i])) {
+			case 0x04: case 0x18: case 0x19: case 0x22: break;
+			default: return 0;
+		}
+	}
+
+	uint8_t buffer[256];
+	uint16_t maxLength = channel.TransferSize == 0 || channel.TransferSize > sizeof(buffer) ? sizeof(buffer) : channel.TransferSize;
+	maxLength = _memoryManager->GetDmaBlockLength(maxLength);
+	if(maxLength == 0) {
+		return 0;
+	}
+
+	int8_t step = channel.FixedTransfer ? 0 : (channel.Decrement ? -1 : 1);
+	uint16_t length = _memoryManager->ReadDmaBlock(channel.SrcBank, channel.SrcAddress, step, buffer, maxLength);
+	if(length == 0) {
+		return 0;
+	}
+
+	_memoryManager->WriteDmaBlock(channel.DestAddress, transferOffsets, offsetIndex, buffer, length);
+
+	channel.SrcAddress += step * length;
+	channel.TransferSize -= length;
+	return length;
+}
+
 bool DmaController::InitHdmaChannels()
 {
 	_hdmaInitPending = false;
@@ -247,6 +291,17 @@ bool DmaController::ProcessHdmaChannels()
 	}
 
 	//Update the channel's state & fetch data for the next scanline
+	//Only table bytes are read here (up to 3 per channel), so when no event or IRQ can occur before the last of them,
+	//they are read directly and the clock is advanced once at the end, like RunDmaBlock does for regular DMA transfers
+	uint16_t maxReads = 0;
+	for(int i = 0; i < 8; i++) {
+		if((_hdmaChannels & (1 << i)) && !_channel[i].HdmaFinished) {
+			maxReads += 3;
+		}
+	}
+	bool readBlock = maxReads > 0 && _memoryManager->GetDmaReadBlockLength(maxReads) == maxReads;
+	uint16_t blockLength = 0;
+
 	for(int i = 0; i < 8; i++) {
 		DmaChannelConfig &ch = _channel[i];
 		if((_hdmaChannels & (1 << i)) == 0 || ch.HdmaFinished) {
@@ -261,8 +316,7 @@ bool DmaController::ProcessHdmaChannels()
 
 		//"a. Read the next byte from Address into $43xA (thus, into both Line Counter and Repeat)."
 		//This value is discarded if the line counter isn't 0
-		uint8_t newCounter = _memoryManager->ReadDma((ch.SrcBank << 16) | ch.HdmaTableAddress, true);
-		_memoryManager->IncMasterClock4();
+		uint8_t newCounter = ReadHdmaTable(ch, readBlock, blockLength);
 
 		//5. If Line Counter is zero...
 		if((ch.HdmaLineCounterAndRepeat & 0x7F) == 0) {
@@ -274,16 +328,15 @@ bool DmaController::ProcessHdmaChannels()
 				if(ch.HdmaLineCounterAndRepeat == 0 && IsLastActiveHdmaChannel(i)) {
 					//"One oddity: if $43xA is 0 and this is the last active HDMA channel for this scanline, only load one byte for Address, 
 					//and use the $00 for the low byte.So Address ends up incremented one less than otherwise expected, and one less CPU Cycle is used."
-					uint8_t msb = _memoryManager->ReadDma((ch.SrcBank << 16) | ch.HdmaTableAddress++, true);
-					_memoryManager->IncMasterClock4();
+					uint8_t msb = ReadHdmaTable(ch, readBlock, blockLength);
+					ch.HdmaTableAddress++;
 					ch.TransferSize = (msb << 8);
 				} else {
 					//"If a new indirect address is required, 16 master cycles are taken to load it."
-					uint8_t lsb = _memoryManager->ReadDma((ch.SrcBank << 16) | ch.HdmaTableAddress++, true);
-					_memoryManager->IncMasterClock4();
-					
-					uint8_t msb = _memoryManager->ReadDma((ch.SrcBank << 16) | ch.HdmaTableAddress++, true);
-					_memoryManager->IncMasterClock4();
+					uint8_t lsb = ReadHdmaTable(ch, readBlock, blockLength);
+					ch.HdmaTableAddress++;
+					uint8_t msb = ReadHdmaTable(ch, readBlock, blockLength);
+					ch.HdmaTableAddress++;
 
 					ch.TransferSize = (msb << 8) | lsb;
 				}				
@@ -299,6 +352,10 @@ bool DmaController::ProcessHdmaChannels()
 		}
 	}
 
+	if(blockLength > 0) {
+		_memoryManager->EndDmaReadBlock(blockLength);
+	}
+
 	if(needSync) {
 		//If we ran a HDMA transfer, sync
 		SyncEndDma();
@@ -310,6 +367,27 @@ bool DmaController::ProcessHdmaChannels()
 	return true;
 }
 
+uint8_t DmaController::ReadHdmaTable(DmaChannelConfig &channel, bool &readBlock, uint16_t &blockLength)
+{
+	//Reads the byte at the channel's table address (without incrementing it, the line counter may be discarded)
+	uint8_t value;
+	if(readBlock && _memoryManager->ReadDmaBlock(channel.SrcBank, channel.HdmaTableAddress, 0, &value, 1)) {
+		blockLength++;
+		return value;
+	}
+
+	//Not plain RAM/ROM, catch up on the bytes read so far and use the regular path for the rest of the table reads
+	if(blockLength > 0) {
+		_memoryManager->EndDmaReadBlock(blockLength);
+		blockLength = 0;
+	}
+	readBlock = false;
+
+	value = _memoryManager->ReadDma((channel.SrcBank << 16) | channel.HdmaTableAddress, true);
+	_memoryManager->IncMasterClock4();
+	return value;
+}
+
 bool DmaController::IsLastActiveHdmaChannel(uint8_t channel)
 {
 	for(int i = channel + 1; i < 8; i++) {
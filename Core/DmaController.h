@@ -27,8 +27,10 @@ private:
 	void CopyDmaByte(uint32_t addressBusA, uint16_t addressBusB, bool fromBtoA);
 
 	void RunDma(DmaChannelConfig &channel);
+	uint16_t RunDmaBlock(DmaChannelConfig &channel, uint8_t offsetIndex);
 	
 	void RunHdmaTransfer(DmaChannelConfig &channel);
+	uint8_t ReadHdmaTable(DmaChannelConfig &channel, bool &readBlock, uint16_t &blockLength);
 	bool ProcessHdmaChannels();
 	bool IsLastActiveHdmaChannel(uint8_t channel);
 	bool InitHdmaChannels();
@@ -48,6 +50,7 @@ public:
 	void BeginHdmaInit();
 
 	bool ProcessPendingTransfers();
+	bool HasPendingTransfers() { return _needToProcess; }
 
 	void Write(uint16_t addr, uint8_t value);
 	uint8_t Read(uint16_t addr);
@@ -625,8 +625,17 @@ void GbPpu::SendFrame()
 	}
 	_isFirstFrame = false;
 
+	if(_console->GetSettings()->CheckFlag(EmulationFlags::Headless)) {
+		//Nothing needs to be decoded or displayed
+		return;
+	}
+
 #ifdef LIBRETRO
-	_console->GetVideoDecoder()->UpdateFrameSync(_currentBuffer, 256, 239, _state.FrameCount, false);
+	if(_console->GetSettings()->GetVideoConfig().EnablePipelinedDecode) {
+		_console->GetVideoDecoder()->UpdateFramePipelined(_currentBuffer, 256, 239, _state.FrameCount);
+	} else {
+		_console->GetVideoDecoder()->UpdateFrameSync(_currentBuffer, 256, 239, _state.FrameCount, false);
+	}
 #else
 	if(_console->GetRewindManager()->IsRewinding()) {
 		_console->GetVideoDecoder()->UpdateFrameSync(_currentBuffer, 256, 239, _state.FrameCount, true);
@@ -33,14 +33,14 @@ Gsu::Gsu(Console *console, uint32_t gsuRamSize) : BaseCoprocessor(SnesMemoryType
 
 	for(uint32_t i = 0; i < _gsuRamSize / 0x1000; i++) {
 		_gsuRamHandlers.push_back(unique_ptr<IMemoryHandler>(new RamHandler(_gsuRam, i * 0x1000, _gsuRamSize, SnesMemoryType::GsuWorkRam)));
-		_gsuCpuRamHandlers.push_back(unique_ptr<IMemoryHandler>(new GsuRamHandler(_state, _gsuRamHandlers.back().get())));
+		_gsuCpuRamHandlers.push_back(unique_ptr<IMemoryHandler>(new GsuRamHandler(_state, this, _gsuRamHandlers.back().get())));
 	}
 	
 	//CPU mappings
 	MemoryMappings *cpuMappings = _memoryManager->GetMemoryMappings();
 	vector<unique_ptr<IMemoryHandler>> &prgRomHandlers = _console->GetCartridge()->GetPrgRomHandlers();
 	for(unique_ptr<IMemoryHandler> &handler : prgRomHandlers) {
-		_gsuCpuRomHandlers.push_back(unique_ptr<IMemoryHandler>(new GsuRomHandler(_state, handler.get())));
+		_gsuCpuRomHandlers.push_back(unique_ptr<IMemoryHandler>(new GsuRomHandler(_state, this, handler.get())));
 	}
 
 	//GSU registers in CPU memory space
@@ -239,7 +239,9 @@ uint8_t Gsu::ReadGsu(uint32_t addr, MemoryOperationType opType)
 	IMemoryHandler *handler = _mappings.GetHandler(addr);
 	uint8_t value;
 	if(handler) {
-		value = handler->Read(addr);
+		if(!_mappings.TryRead(addr, value)) {
+			value = handler->Read(addr);
+		}
 	} else {
 		//TODO: Open bus?
 		value = 0;
@@ -254,7 +256,9 @@ void Gsu::WriteGsu(uint32_t addr, uint8_t value, MemoryOperationType opType)
 {
 	IMemoryHandler *handler = _mappings.GetHandler(addr);
 	if(handler) {
-		handler->Write(addr, value);
+		if(!_mappings.TryWrite(addr, value)) {
+			handler->Write(addr, value);
+		}
 	} else {
 		LogDebug("[Debug] GSU - Missing write handler: " + HexUtilities::ToHex(addr));
 	}
@@ -455,6 +459,9 @@ void Gsu::Reset()
 
 uint8_t Gsu::Read(uint32_t addr)
 {
+	//Catch up the GSU before the CPU reads its registers
+	Run();
+
 	addr &= 0x33FF;
 	if(_state.SFR.Running && addr != 0x3030 && addr != 0x3031 && addr != 0x303B) {
 		//"During GSU operation, only SFR, SCMR, and VCR may be accessed."
@@ -498,6 +505,8 @@ uint8_t Gsu::Read(uint32_t addr)
 
 void Gsu::Write(uint32_t addr, uint8_t value)
 {
+	Run();
+
 	addr &= 0x33FF;
 	if(_state.SFR.Running && addr != 0x3030 && addr != 0x303A) {
 		//"During GSU operation, only SFR, SCMR, and VCR may be accessed."
@@ -2,44 +2,59 @@
 #include "stdafx.h"
 #include "IMemoryHandler.h"
 #include "GsuTypes.h"
+#include "BaseCoprocessor.h"
 
 class GsuRamHandler : public IMemoryHandler
 {
 private:
 	GsuState *_state;
+	BaseCoprocessor *_gsu;
 	IMemoryHandler *_handler;
 
+	__forceinline uint8_t InternalRead(uint32_t addr)
+	{
+		if(!_state->SFR.Running || !_state->GsuRamAccess) {
+			return _handler->Read(addr);
+		}
+
+		//TODO: open bus
+		return 0;
+	}
+
 public:
-	GsuRamHandler(GsuState &state, IMemoryHandler *handler) : IMemoryHandler(SnesMemoryType::GsuWorkRam)
+	GsuRamHandler(GsuState &state, BaseCoprocessor *gsu, IMemoryHandler *handler) : IMemoryHandler(SnesMemoryType::GsuWorkRam)
 	{
 		_handler = handler;
 		_state = &state;
+		_gsu = gsu;
 	}
 
 	uint8_t Read(uint32_t addr) override
 	{
-		if(!_state->SFR.Running || !_state->GsuRamAccess) {
-			return _handler->Read(addr);
+		if(_state->SFR.Running && _state->GsuRamAccess) {
+			//The GSU can stop on its own while it owns the RAM bus, catch it up to find out whether the CPU has access
+			_gsu->Run();
 		}
-
-		//TODO: open bus
-		return 0;
+		return InternalRead(addr);
 	}
 
 	uint8_t Peek(uint32_t addr) override
 	{
-		return Read(addr);
+		return InternalRead(addr);
 	}
 
 	void PeekBlock(uint32_t addr, uint8_t *output) override
 	{
 		for(int i = 0; i < 0x1000; i++) {
-			output[i] = Read(i);
+			output[i] = InternalRead(i);
 		}
 	}
 
 	void Write(uint32_t addr, uint8_t value) override
 	{
+		if(_state->SFR.Running && _state->GsuRamAccess) {
+			_gsu->Run();
+		}
 		if(!_state->SFR.Running || !_state->GsuRamAccess) {
 			_handler->Write(addr, value);
 		}
@@ -2,21 +2,16 @@
 #include "stdafx.h"
 #include "IMemoryHandler.h"
 #include "GsuTypes.h"
+#include "BaseCoprocessor.h"
 
 class GsuRomHandler : public IMemoryHandler
 {
 private:
 	GsuState *_state;
+	BaseCoprocessor *_gsu;
 	IMemoryHandler *_romHandler;
 
-public:
-	GsuRomHandler(GsuState &state, IMemoryHandler *romHandler) : IMemoryHandler(SnesMemoryType::PrgRom)
-	{
-		_romHandler = romHandler;
-		_state = &state;
-	}
-
-	uint8_t Read(uint32_t addr) override
+	__forceinline uint8_t InternalRead(uint32_t addr)
 	{
 		if(!_state->SFR.Running || !_state->GsuRomAccess) {
 			return _romHandler->Read(addr);
@@ -37,15 +32,32 @@ public:
 		}
 	}
 
+public:
+	GsuRomHandler(GsuState &state, BaseCoprocessor *gsu, IMemoryHandler *romHandler) : IMemoryHandler(SnesMemoryType::PrgRom)
+	{
+		_romHandler = romHandler;
+		_state = &state;
+		_gsu = gsu;
+	}
+
+	uint8_t Read(uint32_t addr) override
+	{
+		if(_state->SFR.Running && _state->GsuRomAccess) {
+			//The GSU can stop on its own while it owns the ROM bus, catch it up to find out whether the CPU has access
+			_gsu->Run();
+		}
+		return InternalRead(addr);
+	}
+
 	uint8_t Peek(uint32_t addr) override
 	{
-		return Read(addr);
+		return InternalRead(addr);
 	}
 
 	void PeekBlock(uint32_t addr, uint8_t *output) override
 	{
 		for(int i = 0; i < 0x1000; i++) {
-			output[i] = Read(i);
+			output[i] = InternalRead(i);
 		}
 	}
 
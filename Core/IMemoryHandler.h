@@ -26,4 +26,9 @@ public:
 	}
 
 	virtual AddressInfo GetAbsoluteAddress(uint32_t address) = 0;
+
+	//Handlers for plain RAM/ROM return the memory they map (and the mask applied to the address),
+	//which allows MemoryMappings to read/write their pages directly without calling the handler
+	virtual uint8_t* GetDirectReadPointer(uint32_t &mask) { return nullptr; }
+	virtual uint8_t* GetDirectWritePointer(uint32_t &mask) { return nullptr; }
 };
\ No newline at end of file
@@ -7,6 +7,10 @@ class IRenderingDevice
 	public:
 		virtual ~IRenderingDevice() {}
 		virtual void UpdateFrame(void *frameBuffer, uint32_t width, uint32_t height) = 0;
+
+		//Returns a buffer the next frame can be decoded into directly (pitch is in pixels), or nullptr if the device doesn't provide one
+		//The buffer is only valid until that frame is sent to UpdateFrame
+		virtual uint32_t* GetFrameBuffer(uint32_t width, uint32_t height, uint32_t &pitch) { return nullptr; }
 		virtual void Render() = 0;
 		virtual void Reset() = 0;
 };
@@ -40,6 +40,44 @@ void InternalRegisters::Reset()
 	_irqLevel = false;
 	_needIrq = false;
 	_irqFlag = false;
+	_irqDeadline = 0;
+}
+
+void InternalRegisters::UpdateIrqDeadline()
+{
+	//Calculates the H clock (within the current scanline) before which ProcessIrqCounters can't change anything but the NMI flag.
+	//The scanline only changes at the end of scanline event, which is always followed by a regular poll that updates this value again.
+	if(_needIrq) {
+		_irqDeadline = 0;
+		return;
+	}
+
+	if(!_state.EnableHorizontalIrq && !_state.EnableVerticalIrq) {
+		_irqDeadline = _irqLevel ? 0 : 0xFFFF;
+		return;
+	}
+
+	uint16_t scanline = _ppu->GetRealScanline();
+	bool verticalMatch = !_state.EnableVerticalIrq || scanline == _state.VerticalTimer;
+	if(!_state.EnableHorizontalIrq) {
+		//V-IRQ only: the IRQ level stays the same for the entire scanline
+		_irqDeadline = verticalMatch == _irqLevel ? 0xFFFF : 0;
+		return;
+	}
+
+	uint16_t hTimer = _state.HorizontalTimer;
+	if(_irqLevel) {
+		//The level will drop back on the next cycle
+		_irqDeadline = 0;
+	} else if(!verticalMatch || hTimer > 339 || (hTimer == 339 && _ppu->GetLastScanline() == scanline)) {
+		_irqDeadline = 0xFFFF;
+	} else if(_memoryManager->GetHClock() >= hTimer * 4 + 12) {
+		//H timer position was already passed on this scanline (dots are at most 6 master clocks long)
+		_irqDeadline = 0xFFFF;
+	} else {
+		//Ppu::GetCycle() can't reach the H timer value before H clock = hTimer * 4
+		_irqDeadline = hTimer * 4;
+	}
 }
 
 void InternalRegisters::ProcessAutoJoypadRead()
@@ -175,6 +213,7 @@ void InternalRegisters::Write(uint16_t addr, uint8_t value)
 			
 			SetNmiFlag(_nmiFlag);
 			SetIrqFlag(_irqFlag);
+			UpdateIrqDeadline();
 			break;
 
 		case 0x4201:
@@ -244,4 +283,9 @@ void InternalRegisters::Serialize(Serializer &s)
 	);
 
 	s.Stream(&_aluMulDiv);
+
+	if(!s.IsSaving()) {
+		//Poll the counters until the next regular update
+		_irqDeadline = 0;
+	}
 }
@@ -24,8 +24,10 @@ private:
 	bool _irqLevel = false;
 	uint8_t _needIrq = 0;
 	bool _irqFlag = false;
+	uint16_t _irqDeadline = 0;
 	
 	void SetIrqFlag(bool irqFlag);
+	void UpdateIrqDeadline();
 
 public:
 	InternalRegisters();
@@ -36,6 +38,7 @@ public:
 	void ProcessAutoJoypadRead();
 
 	__forceinline void ProcessIrqCounters();
+	__forceinline uint16_t GetIrqDeadline() { return _irqDeadline; }
 
 	uint8_t GetIoPortOutput();
 	void SetNmiFlag(bool nmiFlag);
@@ -78,4 +81,6 @@ void InternalRegisters::ProcessIrqCounters()
 	}
 	_irqLevel = irqLevel;
 	_cpu->SetNmiFlag(_state.EnableNmi & _nmiFlag);
+
+	UpdateIrqDeadline();
 }
\ No newline at end of file
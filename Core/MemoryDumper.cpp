@@ -37,6 +37,11 @@ void MemoryDumper::SetMemoryState(SnesMemoryType type, uint8_t *buffer, uint32_t
 	uint8_t* dst = GetMemoryBuffer(type);
 	if(dst) {
 		memcpy(dst, buffer, length);
+		if(type == SnesMemoryType::VideoRam) {
+			_ppu->InvalidateTileCache();
+		} else if(type == SnesMemoryType::SpriteRam) {
+			_ppu->InvalidateScanlineSprites();
+		}
 	}
 }
 
@@ -213,6 +218,11 @@ void MemoryDumper::SetMemoryValue(SnesMemoryType memoryType, uint32_t address, u
 			if(src) {
 				src[address] = value;
 				invalidateCache();
+				if(memoryType == SnesMemoryType::VideoRam) {
+					_ppu->InvalidateTileCache();
+				} else if(memoryType == SnesMemoryType::SpriteRam) {
+					_ppu->InvalidateScanlineSprites();
+				}
 			}
 			break;
 	}
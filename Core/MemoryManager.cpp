@@ -128,50 +128,140 @@ void MemoryManager::GenerateMasterClockTable()
 
 void MemoryManager::IncMasterClock4()
 {
-	Exec();
-	Exec();
+	IncrementMasterClockValue(4);
 }
 
 void MemoryManager::IncMasterClock6()
 {
-	Exec();
-	Exec();
-	Exec();
+	IncrementMasterClockValue(6);
 }
 
 void MemoryManager::IncMasterClock8()
 {
-	Exec();
-	Exec();
-	Exec();
-	Exec();
+	IncrementMasterClockValue(8);
 }
 
 void MemoryManager::IncMasterClock40()
 {
-	Exec(); Exec(); Exec(); Exec(); Exec();
-	Exec(); Exec(); Exec(); Exec(); Exec();
-	Exec(); Exec(); Exec(); Exec(); Exec();
-	Exec(); Exec(); Exec(); Exec(); Exec();
+	IncrementMasterClockValue(40);
 }
 
 void MemoryManager::IncMasterClockStartup()
 {
-	for(int i = 0; i < 182 / 2; i++) {
-		Exec();
-	}
+	IncrementMasterClockValue(182);
 }
 
 void MemoryManager::IncrementMasterClockValue(uint16_t cyclesToRun)
 {
-	switch(cyclesToRun) {
-		case 12: Exec();
-		case 10: Exec();
-		case 8: Exec();
-		case 6: Exec();
-		case 4: Exec();
-		case 2: Exec();
+	//Jump straight to the next point in time where something other than the clock needs to be updated,
+	//and only fall back to running 2 master clocks at a time when getting close to that point
+	while(cyclesToRun > 0) {
+		uint16_t clocks = GetFastForwardClocks(cyclesToRun);
+		if(clocks > 0) {
+			FastForward(clocks);
+			cyclesToRun -= clocks;
+		} else {
+			Exec();
+			cyclesToRun -= 2;
+		}
+	}
+}
+
+uint32_t MemoryManager::SkipIdleLoop(uint16_t loopClocks)
+{
+	//Run as many loop iterations as possible (each taking loopClocks master clocks) without reaching the next event
+	uint32_t loopCount = GetFastForwardClocks(0xFFFF) / loopClocks;
+	if(loopCount > 0) {
+		FastForward(loopCount * loopClocks);
+	}
+	return loopCount;
+}
+
+uint16_t MemoryManager::GetDmaBlockLength(uint16_t maxLength)
+{
+	//Number of DMA bytes (8 master clocks each) that can be transferred as a single block, without reaching
+	//the next event or IRQ counter change, and without the PPU rendering anything that the transfer could affect
+	uint16_t length = GetFastForwardClocks(std::min<uint16_t>(maxLength, 0x1FFF) << 3) >> 3;
+	if(length == 0 || !_ppu->CanWriteDmaBlock()) {
+		return 0;
+	}
+	return length;
+}
+
+uint16_t MemoryManager::GetDmaReadBlockLength(uint16_t maxLength)
+{
+	//Same as GetDmaBlockLength, for blocks that only read from bus A (nothing is written to the PPU)
+	return GetFastForwardClocks(std::min<uint16_t>(maxLength, 0x1FFF) << 3) >> 3;
+}
+
+uint16_t MemoryManager::ReadDmaBlock(uint8_t bank, uint16_t addr, int8_t step, uint8_t *dest, uint16_t length)
+{
+	//Reads from work ram (or from any plain RAM/ROM when no coprocessor can access it while the DMA runs)
+	//Stops at the first byte that needs to go through ReadDma() instead
+	bool hasCoprocessor = _cart->GetCoprocessor() != nullptr;
+	uint16_t i = 0;
+	for(; i < length; i++) {
+		uint32_t fullAddr = (bank << 16) | addr;
+		IMemoryHandler* handler = _mappings.GetHandler(fullAddr);
+		uint8_t value;
+		if(!handler || (hasCoprocessor && handler->GetMemoryType() != SnesMemoryType::WorkRam) || !_mappings.TryRead(fullAddr, value)) {
+			break;
+		}
+
+		_memTypeBusA = handler->GetMemoryType();
+		_openBus = value;
+		_cheatManager->ApplyCheat(fullAddr, value);
+		dest[i] = value;
+		addr += step;
+	}
+	return i;
+}
+
+void MemoryManager::WriteDmaBlock(uint8_t destAddress, const uint8_t *destOffsets, uint8_t offsetIndex, const uint8_t *src, uint16_t length)
+{
+	//The NMI flag can only change on an event, so a single edge check covers the whole block
+	_cpu->DetectNmiSignalEdge();
+	_ppu->WriteDmaBlock(destAddress, destOffsets, offsetIndex, src, length);
+	FastForward(length << 3);
+}
+
+void MemoryManager::EndDmaReadBlock(uint16_t length)
+{
+	//Advance the clock for bytes read with ReadDmaBlock that are not written anywhere by the DMA (8 master clocks each)
+	_cpu->DetectNmiSignalEdge();
+	FastForward(length << 3);
+}
+
+uint16_t MemoryManager::GetFastForwardClocks(uint16_t maxClocks)
+{
+	if(_console->IsDebugging()) {
+		//The debugger needs to see every PPU cycle
+		return 0;
 	}
+
+	//Stop 2 clocks before the next event or the next point where the H/V IRQ counters may change state,
+	//to let Exec() process it exactly as it would without skipping
+	uint16_t deadline = std::min(_nextEventClock, _regs->GetIrqDeadline());
+	if(deadline <= _hClock + 2) {
+		return 0;
+	}
+	return std::min<uint16_t>(maxClocks, deadline - _hClock - 2);
+}
+
+void MemoryManager::FastForward(uint16_t clocks)
+{
+	//Equivalent to calling Exec() clocks/2 times when no event is pending and the IRQ counters can't change state:
+	//the IRQ counters only need to be processed once and coprocessors can catch up in a single call.
+	bool irqCounterTick = ((_hClock + clocks) >> 2) != (_hClock >> 2);
+
+	_masterClock += clocks;
+	_hClock += clocks;
+
+	if(irqCounterTick) {
+		_regs->ProcessIrqCounters();
+	}
+
+	_cart->SyncCoprocessors(_masterClock);
 }
 
 void MemoryManager::Exec()
@@ -188,11 +278,13 @@ void MemoryManager::Exec()
 		_regs->ProcessIrqCounters();
 	}
 
-	_cart->SyncCoprocessors();
+	_cart->SyncCoprocessors(_masterClock);
 }
 
 void MemoryManager::ProcessEvent()
 {
+	_eventCount++;
+
 	switch(_nextEvent) {
 		case SnesEventType::HdmaInit:
 			_console->GetDmaController()->BeginHdmaInit();
@@ -245,7 +337,9 @@ uint8_t MemoryManager::Read(uint32_t addr, MemoryOperationType type)
 	uint8_t value;
 	IMemoryHandler *handler = _mappings.GetHandler(addr);
 	if(handler) {
-		value = handler->Read(addr);
+		if(!_mappings.TryRead(addr, value)) {
+			value = handler->Read(addr);
+		}
 		_memTypeBusA = handler->GetMemoryType();
 		_openBus = value;
 	} else {
@@ -268,7 +362,10 @@ uint8_t MemoryManager::ReadDma(uint32_t addr, bool forBusA)
 	uint8_t value;
 	IMemoryHandler* handler = _mappings.GetHandler(addr);
 	if(handler) {
-		if(forBusA && handler == _registerHandlerB.get() && (addr & 0xFF00) == 0x2100) {
+		if(_mappings.TryRead(addr, value)) {
+			//Plain RAM/ROM
+			_memTypeBusA = handler->GetMemoryType();
+		} else if(forBusA && handler == _registerHandlerB.get() && (addr & 0xFF00) == 0x2100) {
 			//Trying to read from bus B using bus A returns open bus
 			value = _openBus;
 		} else if(handler == _registerHandlerA.get()) {
@@ -318,7 +415,9 @@ void MemoryManager::Write(uint32_t addr, uint8_t value, MemoryOperationType type
 	_console->ProcessMemoryWrite<CpuType::Cpu>(addr, value, type);
 	IMemoryHandler* handler = _mappings.GetHandler(addr);
 	if(handler) {
-		handler->Write(addr, value);
+		if(!_mappings.TryWrite(addr, value)) {
+			handler->Write(addr, value);
+		}
 		_memTypeBusA = handler->GetMemoryType();
 	} else {
 		LogDebug("[Debug] Write - missing handler: $" + HexUtilities::ToHex(addr) + " = " + HexUtilities::ToHex(value));
@@ -333,7 +432,10 @@ void MemoryManager::WriteDma(uint32_t addr, uint8_t value, bool forBusA)
 
 	IMemoryHandler* handler = _mappings.GetHandler(addr);
 	if(handler) {
-		if(forBusA && handler == _registerHandlerB.get() && (addr & 0xFF00) == 0x2100) {
+		if(_mappings.TryWrite(addr, value)) {
+			//Plain RAM
+			_memTypeBusA = handler->GetMemoryType();
+		} else if(forBusA && handler == _registerHandlerB.get() && (addr & 0xFF00) == 0x2100) {
 			//Trying to write to bus B using bus A does nothing
 		} else if(handler == _registerHandlerA.get()) {
 			uint16_t regAddr = addr & 0xFFFF;
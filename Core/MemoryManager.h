@@ -46,6 +46,7 @@ private:
 	uint16_t _hClock = 0;
 	uint16_t _nextEventClock = 0;
 	uint16_t _dramRefreshPosition = 0;
+	uint32_t _eventCount = 0;
 	SnesEventType _nextEvent = SnesEventType::DramRefresh;
 	SnesMemoryType _memTypeBusA = SnesMemoryType::PrgRom;
 
@@ -57,6 +58,8 @@ private:
 	uint8_t _masterClockTable[0x800];
 
 	void Exec();
+	uint16_t GetFastForwardClocks(uint16_t maxClocks);
+	void FastForward(uint16_t clocks);
 
 	void ProcessEvent();
 
@@ -74,6 +77,13 @@ public:
 	void IncMasterClock40();
 	void IncMasterClockStartup();
 	void IncrementMasterClockValue(uint16_t value);
+	uint32_t SkipIdleLoop(uint16_t loopClocks);
+
+	uint16_t GetDmaBlockLength(uint16_t maxLength);
+	uint16_t GetDmaReadBlockLength(uint16_t maxLength);
+	uint16_t ReadDmaBlock(uint8_t bank, uint16_t addr, int8_t step, uint8_t *dest, uint16_t length);
+	void WriteDmaBlock(uint8_t destAddress, const uint8_t *destOffsets, uint8_t offsetIndex, const uint8_t *src, uint16_t length);
+	void EndDmaReadBlock(uint16_t length);
 
 	uint8_t Read(uint32_t addr, MemoryOperationType type);
 	uint8_t ReadDma(uint32_t addr, bool forBusA);
@@ -87,6 +97,7 @@ public:
 
 	uint8_t GetOpenBus();
 	uint64_t GetMasterClock();
+	uint32_t GetEventCount() { return _eventCount; }
 	uint16_t GetHClock();
 	uint8_t* DebugGetWorkRam();
 
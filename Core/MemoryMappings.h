@@ -9,11 +9,47 @@ class MemoryMappings
 private:
 	IMemoryHandler* _handlers[0x100 * 0x10] = {};
 
+	//Memory for pages mapped to plain RAM/ROM handlers (nullptr when the handler must be called)
+	uint8_t* _readPages[0x100 * 0x10] = {};
+	uint8_t* _writePages[0x100 * 0x10] = {};
+	uint16_t _pageMasks[0x100 * 0x10] = {};
+
+	void SetHandler(uint16_t page, IMemoryHandler* handler);
+
 public:
 	void RegisterHandler(uint8_t startBank, uint8_t endBank, uint16_t startPage, uint16_t endPage, vector<unique_ptr<IMemoryHandler>>& handlers, uint16_t pageIncrement = 0, uint16_t startPageNumber = 0);
 	void RegisterHandler(uint8_t startBank, uint8_t endBank, uint16_t startAddr, uint16_t endAddr, IMemoryHandler* handler);
 
-	IMemoryHandler* GetHandler(uint32_t addr);
+	__forceinline IMemoryHandler* GetHandler(uint32_t addr)
+	{
+		return _handlers[addr >> 12];
+	}
+
+	__forceinline bool TryRead(uint32_t addr, uint8_t &value)
+	{
+		uint8_t* page = _readPages[addr >> 12];
+		if(page) {
+			value = page[addr & _pageMasks[addr >> 12]];
+			return true;
+		}
+		return false;
+	}
+
+	__forceinline bool HasDirectReadPointer(uint32_t addr)
+	{
+		return _readPages[addr >> 12] != nullptr;
+	}
+
+	__forceinline bool TryWrite(uint32_t addr, uint8_t value)
+	{
+		uint8_t* page = _writePages[addr >> 12];
+		if(page) {
+			page[addr & _pageMasks[addr >> 12]] = value;
+			return true;
+		}
+		return false;
+	}
+
 	AddressInfo GetAbsoluteAddress(uint32_t addr);
 	int GetRelativeAddress(AddressInfo& absAddress, uint8_t startBank = 0);
 
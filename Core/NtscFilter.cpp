@@ -3,6 +3,7 @@
 #include "EmuSettings.h"
 #include "SettingTypes.h"
 #include "Console.h"
+#include "../Utilities/ThreadPool.h"
 
 NtscFilter::NtscFilter(shared_ptr<Console> console) : BaseVideoFilter(console)
 {
@@ -57,29 +58,39 @@ void NtscFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 	uint32_t xOffset = overscan.Left * 2;
 	uint32_t yOffset = overscan.Top * 2 * baseWidth;
 
-	if(useHighResOutput) {
-		snes_ntsc_blit_hires(&_ntscData, ppuOutputBuffer, 512, IsOddFrame() ? 0 : 1, 512, _baseFrameInfo.Height, _ntscBuffer, SNES_NTSC_OUT_WIDTH(256) * 4);
-	} else {
-		snes_ntsc_blit(&_ntscData, ppuOutputBuffer, 256, IsOddFrame() ? 0 : 1, 256, _baseFrameInfo.Height, _ntscBuffer, SNES_NTSC_OUT_WIDTH(256) * 8);
-	}
+	//Each row only depends on its own input row and burst phase (which increases by 1 per row), so bands of rows can be blitted in parallel
+	ThreadPool* pool = ThreadPool::GetSharedPool();
+	uint32_t height = _baseFrameInfo.Height;
+	uint32_t bandCount = std::max<uint32_t>(1, std::min<uint32_t>(pool->GetThreadCount(), height / NtscFilter::MinBandHeight));
+	int burstPhase = IsOddFrame() ? 0 : 1;
+	pool->Run(bandCount, [=](uint32_t band) {
+		uint32_t yFirst = height * band / bandCount;
+		uint32_t yLast = height * (band + 1) / bandCount;
+		int bandBurstPhase = (burstPhase + yFirst) % snes_ntsc_burst_count;
+		if(useHighResOutput) {
+			snes_ntsc_blit_hires(&_ntscData, ppuOutputBuffer + yFirst * 512, 512, bandBurstPhase, 512, yLast - yFirst, _ntscBuffer + yFirst * baseWidth, baseWidth * 4);
+		} else {
+			snes_ntsc_blit(&_ntscData, ppuOutputBuffer + yFirst * 256, 256, bandBurstPhase, 256, yLast - yFirst, _ntscBuffer + yFirst * baseWidth * 2, baseWidth * 8);
+		}
+	});
+
 	VideoConfig cfg = _console->GetSettings()->GetVideoConfig();
+	uint32_t pitch = GetOutputPitch();
 
 	if(cfg.ScanlineIntensity == 0) {
 		for(uint32_t i = 0; i < frameInfo.Height; i+=2) {
-			memcpy(GetOutputBuffer()+i*frameInfo.Width, _ntscBuffer + yOffset + xOffset + i*baseWidth, frameInfo.Width * sizeof(uint32_t));
-			memcpy(GetOutputBuffer()+(i+1)*frameInfo.Width, _ntscBuffer + yOffset + xOffset + i*baseWidth, frameInfo.Width * sizeof(uint32_t));
+			memcpy(GetOutputBuffer()+i*pitch, _ntscBuffer + yOffset + xOffset + i*baseWidth, frameInfo.Width * sizeof(uint32_t));
+			memcpy(GetOutputBuffer()+(i+1)*pitch, _ntscBuffer + yOffset + xOffset + i*baseWidth, frameInfo.Width * sizeof(uint32_t));
 		}
 	} else {
 		uint8_t intensity = (uint8_t)((1.0 - cfg.ScanlineIntensity) * 255);
 		for(uint32_t i = 0; i < frameInfo.Height; i++) {
 			if(i & 0x01) {
-				uint32_t *in = _ntscBuffer + yOffset + xOffset + (i - 1) * baseWidth;
-				uint32_t *out = GetOutputBuffer() + i * frameInfo.Width;
-				for(uint32_t j = 0; j < frameInfo.Width; j++) {
-					out[j] = ApplyScanlineEffect(in[j], intensity);
-				}
+				uint32_t *out = GetOutputBuffer() + i * pitch;
+				memcpy(out, _ntscBuffer + yOffset + xOffset + (i - 1) * baseWidth, frameInfo.Width * sizeof(uint32_t));
+				ApplyScanlineEffect(out, frameInfo.Width, intensity);
 			} else {
-				memcpy(GetOutputBuffer()+i*frameInfo.Width, _ntscBuffer + yOffset + xOffset + i*baseWidth, frameInfo.Width * sizeof(uint32_t));
+				memcpy(GetOutputBuffer()+i*pitch, _ntscBuffer + yOffset + xOffset + i*baseWidth, frameInfo.Width * sizeof(uint32_t));
 			}
 		}
 	}
@@ -8,6 +8,9 @@ class Console;
 class NtscFilter : public BaseVideoFilter
 {
 private:
+	//Smaller bands aren't worth the thread synchronization
+	static constexpr uint32_t MinBandHeight = 16;
+
 	snes_ntsc_setup_t _ntscSetup;
 	snes_ntsc_t _ntscData;
 	uint32_t* _ntscBuffer;
@@ -14,9 +14,26 @@
 #include "MessageManager.h"
 #include "EventType.h"
 #include "RewindManager.h"
+#include "PpuRenderThread.h"
 #include "../Utilities/HexUtilities.h"
 #include "../Utilities/Serializer.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define PPU_USE_SSE2
+
+	#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+		//AVX2 kernels are compiled with the target attribute and only used when the CPU supports them
+		#include <immintrin.h>
+		#define PPU_USE_AVX2
+	#endif
+#endif
+
+#ifdef PPU_COLOR_MATH_CAPTURE
+//Defined by Libretro/ColorMathCompare, which builds this file with PPU_COLOR_MATH_CAPTURE to record the input of the color math/brightness kernels
+void CaptureColorMathInput(const uint16_t *mainScreen, const uint16_t *subScreen, const uint8_t *flags, uint16_t startX, uint16_t endX, uint16_t fixedColor, bool subtract, uint8_t brightness);
+#endif
+
 static constexpr uint8_t _oamSizes[8][2][2] = {
 	{ { 1, 1 }, { 2, 2 } }, //8x8 + 16x16
 	{ { 1, 1 }, { 4, 4 } }, //8x8 + 32x32
@@ -28,11 +45,23 @@ static constexpr uint8_t _oamSizes[8][2][2] = {
 	{ { 2, 4 }, { 4, 4 } }  //16x32 + 32x32
 };
 
-Ppu::Ppu(Console* console)
+Ppu::Ppu()
+{
+	//Render-only instance used by PpuRenderThread: DrawScanline(job) reads the tile data that was fetched by the
+	//emulation thread's PPU and writes to the job's output buffer, so VRAM/tile cache/output buffers are not allocated
+	_console = nullptr;
+
+#ifdef PPU_USE_AVX2
+	_useAvx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+Ppu::Ppu(Console* console) : Ppu()
 {
 	_console = console;
 
 	_vram = new uint16_t[Ppu::VideoRamSize >> 1];
+	_tileCache = new uint8_t[3 * (Ppu::VideoRamSize >> 1) * 8];
 
 	_outputBuffers[0] = new uint16_t[512 * 478];
 	_outputBuffers[1] = new uint16_t[512 * 478];
@@ -42,13 +71,19 @@ Ppu::Ppu(Console* console)
 
 Ppu::~Ppu()
 {
+	//Stop the render thread before freeing the buffers it writes to
+	_renderThread.reset();
+
 	delete[] _vram;
+	delete[] _tileCache;
 	delete[] _outputBuffers[0];
 	delete[] _outputBuffers[1];
 }
 
 void Ppu::PowerOn()
 {
+	WaitForRenderThread();
+
 	_skipRender = false;
 	_regs = _console->GetInternalRegisters().get();
 	_settings = _console->GetSettings().get();
@@ -63,8 +98,12 @@ void Ppu::PowerOn()
 	if(_settings->GetEmulationConfig().EnableRandomPowerOnState) {
 		RandomizeState();
 	}
+	_windowMaskDirty = true;
+	_scanlineSpritesDirty = true;
+	memset(_lineHashes, 0, sizeof(_lineHashes));
 
 	_settings->InitializeRam(_vram, Ppu::VideoRamSize);
+	InvalidateTileCache();
 	_settings->InitializeRam(_cgram, Ppu::CgRamSize);
 	_settings->InitializeRam(_oamRam, Ppu::SpriteRamSize);
 
@@ -236,7 +275,63 @@ void Ppu::GetChrData(uint8_t layerIndex, uint8_t column, uint8_t plane)
 
 	uint8_t yOffset = vMirror ? (7 - baseYOffset) : baseYOffset;
 	uint16_t pixelStart = tileStart + yOffset + (plane << 3);
-	tileData.ChrData[plane + (secondTile ? bpp / 2 : 0)] = _vram[pixelStart & 0x7FFF];
+	uint8_t chrIndex = plane + (secondTile ? bpp / 2 : 0);
+	tileData.ChrData[chrIndex] = _vram[pixelStart & 0x7FFF];
+
+	for(int i = 0; i < 2; i++) {
+		//Discard decoded pixels that were based on the previous value (the BG mode may have changed since they were decoded)
+		uint8_t start = i * tileData.PixelsBpp[i] / 2;
+		if(chrIndex >= start && chrIndex < start + tileData.PixelsBpp[i] / 2) {
+			tileData.PixelsBpp[i] = 0;
+		}
+	}
+
+	if(plane == bpp / 2 - 1) {
+		//All planes for this row of the tile have been fetched
+		LoadTilePixels<bpp>(tileData, secondTile, (pixelStart - (plane << 3)) & 0x7FFF);
+	}
+}
+
+template<uint8_t bpp>
+void Ppu::LoadTilePixels(TileData &tileData, bool secondTile, uint16_t addr)
+{
+	const uint16_t* chrData = tileData.ChrData + (secondTile ? bpp / 2 : 0);
+	uint8_t* pixels = tileData.Pixels[secondTile];
+	tileData.PixelsBpp[secondTile] = bpp;
+
+	for(int i = 0; i < bpp / 2; i++) {
+		if(chrData[i] != _vram[(addr + (i << 3)) & 0x7FFF]) {
+			//The planes weren't all fetched from this row (the BG settings changed in the middle of the tile), don't use the cache
+			for(int j = 0; j < 8; j++) {
+				pixels[j] = GetTilePixelColor<bpp>(chrData, 7 - j);
+			}
+			return;
+		}
+	}
+
+	constexpr uint8_t cacheIndex = bpp == 2 ? 0 : (bpp == 4 ? 1 : 2);
+	uint8_t* cachedPixels = _tileCache + (((cacheIndex << 15) | addr) << 3);
+	if(!(_tileCacheValid[addr] & (1 << cacheIndex))) {
+		for(int j = 0; j < 8; j++) {
+			cachedPixels[j] = GetTilePixelColor<bpp>(chrData, 7 - j);
+		}
+		_tileCacheValid[addr] |= (1 << cacheIndex);
+	}
+	memcpy(pixels, cachedPixels, 8);
+}
+
+void Ppu::InvalidateTileCache(uint16_t addr)
+{
+	//A row is made up of 1, 2 or 4 words (for 2, 4 or 8bpp), 8 words apart
+	_tileCacheValid[addr] = 0;
+	_tileCacheValid[(addr - 8) & 0x7FFF] &= ~0x06;
+	_tileCacheValid[(addr - 16) & 0x7FFF] &= ~0x04;
+	_tileCacheValid[(addr - 24) & 0x7FFF] &= ~0x04;
+}
+
+void Ppu::InvalidateTileCache()
+{
+	memset(_tileCacheValid, 0, sizeof(_tileCacheValid));
 }
 
 void Ppu::GetHorizontalOffsetByte(uint8_t columnIndex)
@@ -421,7 +516,7 @@ bool Ppu::ProcessEndOfScanline(uint16_t hClock)
 
 			memset(_hasSpritePriority, 0, sizeof(_hasSpritePriority));
 			memcpy(_spritePriority, _spritePriorityCopy, sizeof(_spritePriority));
-			for(int i = 0; i < 255; i++) {
+			for(int i = 0; i < 256; i++) {
 				if(_spritePriority[i] < 4) {
 					_hasSpritePriority[_spritePriority[i]] = true;
 				}
@@ -448,8 +543,27 @@ bool Ppu::ProcessEndOfScanline(uint16_t hClock)
 				_internalOamAddress = (_state.OamRamAddress << 1);
 			}
 
+			//All scanlines must be drawn before the frame is sent
+			WaitForRenderThread();
+
 			VideoConfig cfg = _settings->GetVideoConfig();
 			_configVisibleLayers = (cfg.HideBgLayer0 ? 0 : 1) | (cfg.HideBgLayer1 ? 0 : 2) | (cfg.HideBgLayer2 ? 0 : 4) | (cfg.HideBgLayer3 ? 0 : 8) | (cfg.HideSprites ? 0 : 16);
+			_lineCacheEnabled = cfg.EnableLineCache;
+
+			_prevFrameLineCacheStats.Hits = _lineCacheStats.Hits - _frameLineCacheStats.Hits;
+			_prevFrameLineCacheStats.Misses = _lineCacheStats.Misses - _frameLineCacheStats.Misses;
+			_frameLineCacheStats = _lineCacheStats;
+
+			//Stop hashing scanlines for a while when most of them had to be drawn again (e.g. while the screen scrolls)
+			if(_lineCacheSkipFrames > 0) {
+				_lineCacheSkipFrames--;
+			} else if(_prevFrameLineCacheStats.Hits < _prevFrameLineCacheStats.Misses) {
+				_lineCacheSkipFrames = 30;
+			}
+
+			if(cfg.EnableRenderThread != (_renderThread != nullptr)) {
+				_renderThread.reset(cfg.EnableRenderThread ? new PpuRenderThread() : nullptr);
+			}
 
 			_console->ProcessEvent(EventType::EndFrame);
 
@@ -468,7 +582,7 @@ bool Ppu::ProcessEndOfScanline(uint16_t hClock)
 			_timeOver = false;
 			_console->ProcessEvent(EventType::StartFrame);
 
-			_skipRender = (
+			_skipRender = _settings->CheckFlag(EmulationFlags::Headless) || (
 				!_settings->GetVideoConfig().DisableFrameSkipping &&
 				!_console->GetRewindManager()->IsRewinding() &&
 				!_console->GetVideoRenderer()->IsRecording() &&
@@ -570,25 +684,88 @@ void Ppu::EvaluateNextLineSprites()
 		return;
 	}
 
-	for(int i = _spriteEvalStart; i <= _spriteEvalEnd; i++) {
-		if(!(i & 0x01)) {
-			//First cycle, read X & Y and high oam byte
-			FetchSpritePosition(_oamEvaluationIndex << 2);
-		} else {
-			//Second cycle: Check if sprite is in range, if so, keep its index
-			if(_currentSprite.IsVisible(_scanline, _state.ObjInterlace)) {
-				if(_spriteCount < 32) {
-					_spriteIndexes[_spriteCount] = _oamEvaluationIndex;
-					_spriteCount++;
-				} else {
-					_rangeOver = true;
+	if(_scanlineSpritesDirty && _spriteEvalStart > 0) {
+		//OAM was changed in the middle of the evaluation, check the remaining sprites one by one
+		for(int i = _spriteEvalStart; i <= _spriteEvalEnd; i++) {
+			if(!(i & 0x01)) {
+				//First cycle, read X & Y and high oam byte
+				FetchSpritePosition(_oamEvaluationIndex << 2);
+			} else {
+				//Second cycle: Check if sprite is in range, if so, keep its index
+				if(_currentSprite.IsVisible(_scanline, _state.ObjInterlace)) {
+					if(_spriteCount < 32) {
+						_spriteIndexes[_spriteCount] = _oamEvaluationIndex;
+						_spriteCount++;
+					} else {
+						_rangeOver = true;
+					}
 				}
+				_oamEvaluationIndex = (_oamEvaluationIndex + 1) & 0x7F;
 			}
-			_oamEvaluationIndex = (_oamEvaluationIndex + 1) & 0x7F;
 		}
+		return;
+	}
+
+	if(_scanlineSpritesDirty) {
+		UpdateScanlineSprites();
+	}
+
+	//Each sprite takes 2 cycles: its position is read on the first cycle and it is checked on the second cycle
+	const uint64_t* sprites = _scanline < 256 ? _scanlineSprites[_scanline] : nullptr;
+	for(int i = _spriteEvalStart | 0x01; i <= _spriteEvalEnd; i += 2) {
+		if(sprites && ((sprites[_oamEvaluationIndex >> 6] >> (_oamEvaluationIndex & 0x3F)) & 0x01)) {
+			if(_spriteCount < 32) {
+				_spriteIndexes[_spriteCount] = _oamEvaluationIndex;
+				_spriteCount++;
+			} else {
+				_rangeOver = true;
+			}
+		}
+		_oamEvaluationIndex = (_oamEvaluationIndex + 1) & 0x7F;
+	}
+
+	if(!(_spriteEvalEnd & 0x01)) {
+		//The next sprite's position was read on the last cycle, it will be checked on the next call
+		FetchSpritePosition(_oamEvaluationIndex << 2);
 	}
 }
 
+void Ppu::UpdateScanlineSprites()
+{
+	memset(_scanlineSprites, 0, sizeof(_scanlineSprites));
+
+	for(int i = 0; i < 128; i++) {
+		uint8_t highTableValue = _oamRam[0x200 | (i >> 2)] >> ((i & 0x03) << 1);
+		uint8_t largeSprite = (highTableValue & 0x02) >> 1;
+		int16_t x = (int16_t)((((highTableValue & 0x01) << 8) | _oamRam[i << 2]) << 7) >> 7;
+		uint8_t width = _oamSizes[_state.OamMode][largeSprite][0] << 3;
+		if(x != -256 && (x + width <= 0 || x > 255)) {
+			//Sprite is not visible (and must be ignored for time/range flag calculations), see SpriteInfo::IsVisible
+			continue;
+		}
+
+		uint8_t y = _oamRam[(i << 2) + 1];
+		uint8_t height = _oamSizes[_state.OamMode][largeSprite][1] << 3;
+		if(_state.ObjInterlace) {
+			height >>= 1;
+		}
+
+		//Sprites that go past the bottom of the 256-line range are only in range of the top lines (the lines above 256 are skipped)
+		int start = y + height > 255 ? 0 : y;
+		int end = y + height > 255 ? y + height - 256 : y + height;
+		for(int scanline = start; scanline < end; scanline++) {
+			_scanlineSprites[scanline][i >> 6] |= 1ULL << (i & 0x3F);
+		}
+	}
+
+	_scanlineSpritesDirty = false;
+}
+
+void Ppu::InvalidateScanlineSprites()
+{
+	_scanlineSpritesDirty = true;
+}
+
 void Ppu::FetchSpriteData()
 {
 	//From H=272 to 339, fetch a single word of CHR data on every cycle (for up to 34 sprites)
@@ -845,27 +1022,44 @@ void Ppu::RenderScanline()
 	if(!_skipRender && _drawStartX <= 255 && hPos > 22 && _scanline > 0) {
 		_drawEndX = std::min(hPos - 22, 255);
 
-		if(_state.ForcedVblank) {
-			//Forced blank, output black
-			memset(_mainScreenBuffer + _drawStartX, 0, (_drawEndX - _drawStartX + 1) * 2);
-			memset(_subScreenBuffer + _drawStartX, 0, (_drawEndX - _drawStartX + 1) * 2);
+		if(_windowMaskDirty) {
+			UpdateWindowMasks();
+		}
+
+		if(_useHighResOutput) {
+			_interlacedFrame |= _state.ScreenInterlace;
+		}
+
+		//Scanlines drawn in a single step can be copied from the previous frame if nothing they use has changed
+		//Mode 7 reads VRAM while drawing and interlaced frames don't alternate between the 2 buffers, so these are always drawn
+		uint8_t bufferIndex = _currentBuffer == _outputBuffers[0] ? 0 : 1;
+		uint64_t lineHash = 0;
+		if(_lineCacheEnabled && _lineCacheSkipFrames == 0 && _drawStartX == 0 && _drawEndX == 255 && _state.BgMode != 7 && !_interlacedFrame) {
+			lineHash = GetScanlineHash();
+		}
+
+		if(lineHash && lineHash == _lineHashes[bufferIndex ^ 1][_scanline]) {
+			uint16_t *previousBuffer = _outputBuffers[bufferIndex ^ 1];
+			uint16_t scanline = _overscanFrame ? (_scanline - 1) : (_scanline + 6);
+			if(_useHighResOutput) {
+				memcpy(_currentBuffer + (scanline << 10), previousBuffer + (scanline << 10), 1024 * sizeof(uint16_t));
+			} else {
+				memcpy(_currentBuffer + (scanline << 8), previousBuffer + (scanline << 8), 256 * sizeof(uint16_t));
+			}
+			_lineCacheStats.Hits++;
 		} else {
-			switch(_state.BgMode) {
-				case 0: RenderMode0(); break;
-				case 1: RenderMode1(); break;
-				case 2: RenderMode2(); break;
-				case 3: RenderMode3(); break;
-				case 4: RenderMode4(); break;
-				case 5: RenderMode5(); break;
-				case 6: RenderMode6(); break;
-				case 7: RenderMode7(); break;
+			if(lineHash && _lineHashes[bufferIndex ^ 1][_scanline]) {
+				_lineCacheStats.Misses++;
 			}
-			RenderBgColor();
-		}
 
-		ApplyColorMath();
-		ApplyBrightness<true>();
-		ApplyHiResMode();
+			if(_renderThread && _drawStartX == 0 && _drawEndX == 255 && _state.BgMode != 7) {
+				//Nothing changed during the scanline, let the render thread draw it (mode 7 reads VRAM while drawing, so it is always drawn here)
+				QueueScanline();
+			} else {
+				DrawScanline();
+			}
+		}
+		_lineHashes[bufferIndex][_scanline] = lineHash;
 
 		_drawStartX = _drawEndX + 1;
 	}
@@ -881,6 +1075,187 @@ void Ppu::RenderScanline()
 	}
 }
 
+void Ppu::DrawScanline()
+{
+	if(_state.ForcedVblank) {
+		//Forced blank, output black
+		memset(_mainScreenBuffer + _drawStartX, 0, (_drawEndX - _drawStartX + 1) * 2);
+		memset(_subScreenBuffer + _drawStartX, 0, (_drawEndX - _drawStartX + 1) * 2);
+	} else {
+		switch(_state.BgMode) {
+			case 0: RenderMode0(); break;
+			case 1: RenderMode1(); break;
+			case 2: RenderMode2(); break;
+			case 3: RenderMode3(); break;
+			case 4: RenderMode4(); break;
+			case 5: RenderMode5(); break;
+			case 6: RenderMode6(); break;
+			case 7: RenderMode7(); break;
+		}
+		RenderBgColor();
+	}
+
+	ApplyColorMath();
+	ApplyBrightness<true>();
+	ApplyHiResMode();
+}
+
+static __forceinline uint64_t HashScanlineData(uint64_t hash, uint64_t value)
+{
+	hash += value * 0xC2B2AE3D27D4EB4FULL;
+	hash = (hash << 31) | (hash >> 33);
+	return hash * 0x9E3779B185EBCA87ULL;
+}
+
+static uint64_t HashScanlineData(uint64_t hash, const void *data, size_t size)
+{
+	//Hash 32 bytes at a time in 4 independent lanes, the remaining bytes are added to the first lane
+	const uint8_t *bytes = (const uint8_t*)data;
+	uint64_t lanes[4] = { hash, hash + 1, hash + 2, hash + 3 };
+	size_t i = 0;
+	for(; i + 32 <= size; i += 32) {
+		uint64_t values[4];
+		memcpy(values, bytes + i, sizeof(values));
+		for(int j = 0; j < 4; j++) {
+			lanes[j] = HashScanlineData(lanes[j], values[j]);
+		}
+	}
+	for(; i < size; i += 8) {
+		uint64_t value = 0;
+		memcpy(&value, bytes + i, std::min<size_t>(8, size - i));
+		lanes[0] = HashScanlineData(lanes[0], value);
+	}
+	return HashScanlineData(HashScanlineData(HashScanlineData(lanes[0], lanes[1]), lanes[2]), lanes[3]);
+}
+
+uint64_t Ppu::GetScanlineHash()
+{
+	//Covers the data used to draw a scanline in modes 0 to 6 (the same data as PpuScanlineJob)
+	//Registers that only affect CPU accesses, mode 7 or the sprite fetching are cleared (the fetched sprite pixels are hashed instead)
+	PpuState state = _state;
+	state.Cycle = state.Scanline = state.HClock = 0;
+	state.FrameCount = 0;
+	memset(&state.Mode7, 0, sizeof(state.Mode7));
+	state.VramAddress = state.VramReadBuffer = 0;
+	state.VramIncrementValue = state.VramAddressRemapping = 0;
+	state.VramAddrIncrementOnSecondReg = false;
+	state.Ppu1OpenBus = state.Ppu2OpenBus = 0;
+	state.CgramAddress = state.CgramWriteBuffer = 0;
+	state.CgramAddressLatch = false;
+	state.OamRamAddress = state.OamBaseAddress = state.OamAddressOffset = 0;
+	state.OamMode = 0;
+	state.EnableOamPriority = state.ObjInterlace = false;
+
+	uint64_t hash = HashScanlineData(0x27D4EB2F165667C5ULL, &state, sizeof(state));
+	hash = HashScanlineData(hash, _scanline | (_mosaicScanlineCounter << 16) | ((uint64_t)_configVisibleLayers << 32) | ((uint64_t)_overscanFrame << 40) | ((uint64_t)_useHighResOutput << 48));
+
+	//Only the layers drawn in the current BG mode, the tile data of other layers is left over from previous scanlines
+	constexpr static uint8_t layerCount[7] = { 4, 3, 2, 2, 2, 2, 1 };
+	for(int i = 0; i < layerCount[_state.BgMode]; i++) {
+		if(!IsRenderRequired(i)) {
+			continue;
+		}
+
+		uint64_t lanes[4] = { hash, hash + 1, hash + 2, hash + i };
+		for(int j = 0; j < 33; j++) {
+			const TileData &tile = _layerData[i].Tiles[j];
+			int lane = (j & 0x01) << 1;
+			lanes[lane] = HashScanlineData(lanes[lane], tile.TilemapData | ((uint64_t)tile.VScroll << 16) | ((uint64_t)tile.ChrData[0] << 32) | ((uint64_t)tile.ChrData[1] << 48));
+			lanes[lane + 1] = HashScanlineData(lanes[lane + 1], tile.ChrData[2] | ((uint64_t)tile.ChrData[3] << 16));
+		}
+		hash = HashScanlineData(HashScanlineData(HashScanlineData(lanes[0], lanes[1]), lanes[2]), lanes[3]);
+	}
+
+	hash = HashScanlineData(hash, _cgram, sizeof(_cgram));
+	hash = HashScanlineData(hash, _windowMask, sizeof(_windowMask));
+
+	//The sprite buffers are ignored by RenderSprites when no sprite pixel was fetched for the scanline
+	uint32_t hasSpritePriority;
+	memcpy(&hasSpritePriority, _hasSpritePriority, sizeof(hasSpritePriority));
+	hash = HashScanlineData(hash, hasSpritePriority);
+	if(hasSpritePriority) {
+		hash = HashScanlineData(hash, _spritePriority, sizeof(_spritePriority));
+		hash = HashScanlineData(hash, _spritePalette, sizeof(_spritePalette));
+		hash = HashScanlineData(hash, _spriteColors, sizeof(_spriteColors));
+	}
+
+	hash ^= hash >> 33;
+	hash *= 0x165667B19E3779F9ULL;
+	hash ^= hash >> 29;
+
+	//0 is used for lines that can't be copied
+	return hash ? hash : 1;
+}
+
+void Ppu::InvalidateLineHashes(uint16_t *buffer)
+{
+	memset(_lineHashes[buffer == _outputBuffers[0] ? 0 : 1], 0, sizeof(_lineHashes[0]));
+}
+
+PpuLineCacheStats Ppu::GetLineCacheStats()
+{
+	//Number of scanlines copied/drawn by the line cache during the last frame
+	return _prevFrameLineCacheStats;
+}
+
+void Ppu::DrawScanline(const PpuScanlineJob &job)
+{
+	_state = job.State;
+	memcpy(_layerData, job.Layers, sizeof(_layerData));
+	memcpy(_cgram, job.Cgram, sizeof(_cgram));
+	memcpy(_windowMask, job.WindowMask, sizeof(_windowMask));
+	memcpy(_spritePriority, job.SpritePriority, sizeof(_spritePriority));
+	memcpy(_spritePalette, job.SpritePalette, sizeof(_spritePalette));
+	memcpy(_spriteColors, job.SpriteColors, sizeof(_spriteColors));
+	memcpy(_hasSpritePriority, job.HasSpritePriority, sizeof(_hasSpritePriority));
+
+	_currentBuffer = job.OutputBuffer;
+	_scanline = job.Scanline;
+	_mosaicScanlineCounter = job.MosaicScanlineCounter;
+	_configVisibleLayers = job.ConfigVisibleLayers;
+	_oddFrame = job.OddFrame;
+	_overscanFrame = job.OverscanFrame;
+	_useHighResOutput = job.UseHighResOutput;
+
+	_drawStartX = 0;
+	_drawEndX = 255;
+	memset(_mainScreenFlags, 0, sizeof(_mainScreenFlags));
+	memset(_subScreenPriority, 0, sizeof(_subScreenPriority));
+
+	DrawScanline();
+}
+
+void Ppu::QueueScanline()
+{
+	PpuScanlineJob &job = _renderThread->GetNextJob();
+
+	job.State = _state;
+	memcpy(job.Layers, _layerData, sizeof(job.Layers));
+	memcpy(job.Cgram, _cgram, sizeof(job.Cgram));
+	memcpy(job.WindowMask, _windowMask, sizeof(job.WindowMask));
+	memcpy(job.SpritePriority, _spritePriority, sizeof(job.SpritePriority));
+	memcpy(job.SpritePalette, _spritePalette, sizeof(job.SpritePalette));
+	memcpy(job.SpriteColors, _spriteColors, sizeof(job.SpriteColors));
+	memcpy(job.HasSpritePriority, _hasSpritePriority, sizeof(job.HasSpritePriority));
+
+	job.OutputBuffer = _currentBuffer;
+	job.Scanline = _scanline;
+	job.MosaicScanlineCounter = _mosaicScanlineCounter;
+	job.ConfigVisibleLayers = _configVisibleLayers;
+	job.OddFrame = _oddFrame;
+	job.OverscanFrame = _overscanFrame;
+	job.UseHighResOutput = _useHighResOutput;
+
+	_renderThread->QueueJob();
+}
+
+void Ppu::WaitForRenderThread()
+{
+	if(_renderThread) {
+		_renderThread->WaitUntilIdle();
+	}
+}
+
 void Ppu::RenderBgColor()
 {
 	uint8_t pixelFlags = (_state.ColorMathEnabled & 0x20) ? PixelFlags::AllowColorMath : 0;
@@ -901,28 +1276,27 @@ void Ppu::RenderSprites(const uint8_t priority[4])
 		return;
 	}
 
+	if(!_hasSpritePriority[0] && !_hasSpritePriority[1] && !_hasSpritePriority[2] && !_hasSpritePriority[3]) {
+		//No sprite pixels on this scanline
+		return;
+	}
+
 	bool drawMain = (bool)(((_state.MainScreenLayers & _configVisibleLayers) >> Ppu::SpriteLayerIndex) & 0x01);
 	bool drawSub = (bool)(((_state.SubScreenLayers & _configVisibleLayers) >> Ppu::SpriteLayerIndex) & 0x01);
 
-	uint8_t mainWindowCount = 0;
-	uint8_t subWindowCount = 0;
-	if(_state.WindowMaskMain[Ppu::SpriteLayerIndex]) {
-		mainWindowCount = (uint8_t)_state.Window[0].ActiveLayers[Ppu::SpriteLayerIndex] + (uint8_t)_state.Window[1].ActiveLayers[Ppu::SpriteLayerIndex];
-	}
-	if(_state.WindowMaskSub[Ppu::SpriteLayerIndex]) {
-		subWindowCount = (uint8_t)_state.Window[0].ActiveLayers[Ppu::SpriteLayerIndex] + (uint8_t)_state.Window[1].ActiveLayers[Ppu::SpriteLayerIndex];
-	}
+	bool mainWindowEnabled = _state.WindowMaskMain[Ppu::SpriteLayerIndex];
+	bool subWindowEnabled = _state.WindowMaskSub[Ppu::SpriteLayerIndex];
 
 	for(int x = _drawStartX; x <= _drawEndX; x++) {
 		if(_spritePriority[x] <= 3) {
 			uint8_t spritePrio = priority[_spritePriority[x]];
-			if(drawMain && ((_mainScreenFlags[x] & 0x0F) < spritePrio) && !ProcessMaskWindow<Ppu::SpriteLayerIndex>(mainWindowCount, x)) {
+			if(drawMain && ((_mainScreenFlags[x] & 0x0F) < spritePrio) && !ProcessMaskWindow<Ppu::SpriteLayerIndex>(mainWindowEnabled, x)) {
 				uint16_t paletteRamOffset = 128 + (_spritePalette[x] << 4) + _spriteColors[x];
 				_mainScreenBuffer[x] = _cgram[paletteRamOffset];
 				_mainScreenFlags[x] = spritePrio | (((_state.ColorMathEnabled & 0x10) && _spritePalette[x] > 3) ? PixelFlags::AllowColorMath : 0);
 			}
 
-			if(drawSub && (_subScreenPriority[x] < spritePrio) && !ProcessMaskWindow<Ppu::SpriteLayerIndex>(subWindowCount, x)) {
+			if(drawSub && (_subScreenPriority[x] < spritePrio) && !ProcessMaskWindow<Ppu::SpriteLayerIndex>(subWindowEnabled, x)) {
 				uint16_t paletteRamOffset = 128 + (_spritePalette[x] << 4) + _spriteColors[x];
 				_subScreenBuffer[x] = _cgram[paletteRamOffset];
 				_subScreenPriority[x] = spritePrio;
@@ -937,8 +1311,8 @@ void Ppu::RenderTilemap()
 	bool drawMain = (bool)(((_state.MainScreenLayers & _configVisibleLayers) >> layerIndex) & 0x01);
 	bool drawSub = (bool)(((_state.SubScreenLayers & _configVisibleLayers) >> layerIndex) & 0x01);
 
-	uint8_t mainWindowCount = _state.WindowMaskMain[layerIndex] ? (uint8_t)_state.Window[0].ActiveLayers[layerIndex] + (uint8_t)_state.Window[1].ActiveLayers[layerIndex] : 0;
-	uint8_t subWindowCount = _state.WindowMaskSub[layerIndex] ? (uint8_t)_state.Window[0].ActiveLayers[layerIndex] + (uint8_t)_state.Window[1].ActiveLayers[layerIndex] : 0;
+	bool mainWindowEnabled = _state.WindowMaskMain[layerIndex];
+	bool subWindowEnabled = _state.WindowMaskSub[layerIndex];
 
 	uint16_t hScrollOriginal = _state.Layers[layerIndex].HScroll;
 	uint16_t hScroll = hiResMode ? (hScrollOriginal << 1) : hScrollOriginal;
@@ -948,36 +1322,36 @@ void Ppu::RenderTilemap()
 	uint8_t mosaicCounter = applyMosaic ? _state.MosaicSize - (_drawStartX % _state.MosaicSize) : 0;
 
 	uint8_t lookupIndex;
-	uint8_t chrDataOffset;
+	uint8_t secondTile;
 	uint8_t hiresSubColor;
 	uint8_t pixelFlags = (((_state.ColorMathEnabled >> layerIndex) & 0x01) ? PixelFlags::AllowColorMath : 0);
 
 	for(int x = _drawStartX; x <= _drawEndX; x++) {
 		if(hiResMode) {
 			lookupIndex = (x + (hScrollOriginal & 0x07)) >> 2;
-			chrDataOffset = (lookupIndex & 0x01) * bpp / 2;
+			secondTile = lookupIndex & 0x01;
 			lookupIndex >>= 1;
 		} else {
 			lookupIndex = (x + (hScrollOriginal & 0x07)) >> 3;
 		}
 
-		uint16_t tilemapData = tileData[lookupIndex].TilemapData;
-		uint16_t* chrData = tileData[lookupIndex].ChrData;
+		const TileData &tile = tileData[lookupIndex];
+		uint16_t tilemapData = tile.TilemapData;
 		bool hMirror = (tilemapData & 0x4000) != 0;
 
 		uint8_t color;
 		if(hiResMode) {
 			uint8_t xOffset = ((x << 1) + 1 + hScroll) & 0x07;
 			uint8_t shift = hMirror ? xOffset : (7 - xOffset);
-			color = GetTilePixelColor<bpp>(chrData + chrDataOffset, shift);
+			color = GetTilePixelColor<bpp>(tile, secondTile, shift);
 			
 			xOffset = ((x << 1) + hScroll) & 0x07;
 			shift = hMirror ? xOffset : (7 - xOffset);
-			hiresSubColor = GetTilePixelColor<bpp>(chrData + chrDataOffset, shift);
+			hiresSubColor = GetTilePixelColor<bpp>(tile, secondTile, shift);
 		} else {
 			uint8_t xOffset = (x + hScroll) & 0x07;
 			uint8_t shift = hMirror ? xOffset : (7 - xOffset);
-			color = GetTilePixelColor<bpp>(chrData, shift);
+			color = GetTilePixelColor<bpp>(tile, 0, shift);
 		}
 
 		uint8_t paletteIndex = (tilemapData >> 10) & 0x07;
@@ -1004,16 +1378,16 @@ void Ppu::RenderTilemap()
 
 		if(color > 0) {
 			uint16_t rgbColor = GetRgbColor<bpp, directColorMode, basePaletteOffset>(paletteIndex, color);
-			if(drawMain && (_mainScreenFlags[x] & 0x0F) < priority && !ProcessMaskWindow<layerIndex>(mainWindowCount, x)) {
+			if(drawMain && (_mainScreenFlags[x] & 0x0F) < priority && !ProcessMaskWindow<layerIndex>(mainWindowEnabled, x)) {
 				DrawMainPixel(x, rgbColor, priority | pixelFlags);
 			}
-			if(!hiResMode && drawSub && _subScreenPriority[x] < priority && !ProcessMaskWindow<layerIndex>(subWindowCount, x)) {
+			if(!hiResMode && drawSub && _subScreenPriority[x] < priority && !ProcessMaskWindow<layerIndex>(subWindowEnabled, x)) {
 				DrawSubPixel(x, rgbColor, priority);
 			}
 		}
 
 		if(hiResMode) {
-			if(hiresSubColor > 0 && drawSub && _subScreenPriority[x] < priority && !ProcessMaskWindow<layerIndex>(subWindowCount, x)) {
+			if(hiresSubColor > 0 && drawSub && _subScreenPriority[x] < priority && !ProcessMaskWindow<layerIndex>(subWindowEnabled, x)) {
 				uint16_t hiresSubRgbColor = GetRgbColor<bpp, directColorMode, basePaletteOffset>(paletteIndex, hiresSubColor);
 				DrawSubPixel(x, hiresSubRgbColor, priority);
 			}
@@ -1077,11 +1451,109 @@ uint8_t Ppu::GetTilePixelColor(const uint16_t chrData[4], const uint8_t shift)
 	return color;
 }
 
+template<uint8_t bpp>
+uint8_t Ppu::GetTilePixelColor(const TileData &tileData, const uint8_t tile, const uint8_t shift)
+{
+	if(tileData.PixelsBpp[tile] == bpp) {
+		return tileData.Pixels[tile][7 - shift];
+	} else {
+		//The BG mode changed after the tile was fetched, or a state was just loaded - decode the pixel from the raw CHR data
+		return GetTilePixelColor<bpp>(tileData.ChrData + tile * bpp / 2, shift);
+	}
+}
+
+uint16_t Ppu::GetMode7Pixel(int32_t xOffset, int32_t yOffset)
+{
+	uint8_t tileIndex;
+	if(!_state.Mode7.LargeMap) {
+		yOffset &= 0x3FF;
+		xOffset &= 0x3FF;
+		tileIndex = (uint8_t)_vram[((yOffset & ~0x07) << 4) | (xOffset >> 3)];
+	} else {
+		if(yOffset < 0 || yOffset > 0x3FF || xOffset < 0 || xOffset > 0x3FF) {
+			if(_state.Mode7.FillWithTile0) {
+				tileIndex = 0;
+			} else {
+				return Ppu::Mode7NoPixel;
+			}
+		} else {
+			tileIndex = (uint8_t)_vram[((yOffset & ~0x07) << 4) | (xOffset >> 3)];
+		}
+	}
+
+	return _vram[((tileIndex << 6) + ((yOffset & 0x07) << 3) + (xOffset & 0x07))] >> 8;
+}
+
+void Ppu::FetchMode7Pixels(int32_t xValue, int32_t yValue, int16_t xStep, int16_t yStep, uint16_t *pixels)
+{
+	int x = _drawStartX;
+
+#ifdef PPU_USE_SSE2
+	//Calculate the coordinates and VRAM addresses for 4 pixels at once, only the VRAM reads are done one pixel at a time
+	const __m128i mapMask = _mm_set1_epi32(0x3FF);
+	const __m128i tileRowMask = _mm_set1_epi32(0x3F8);
+	const __m128i fineMask = _mm_set1_epi32(0x07);
+	const __m128i outsideMask = _mm_set1_epi32(_state.Mode7.LargeMap ? ~0x3FF : 0);
+	const __m128i xIncrement = _mm_set1_epi32(xStep * 4);
+	const __m128i yIncrement = _mm_set1_epi32(yStep * 4);
+	bool fillWithTile0 = _state.Mode7.FillWithTile0;
+
+	__m128i xValues = _mm_setr_epi32(xValue, xValue + xStep, xValue + xStep * 2, xValue + xStep * 3);
+	__m128i yValues = _mm_setr_epi32(yValue, yValue + yStep, yValue + yStep * 2, yValue + yStep * 3);
+
+	for(; x + 3 <= _drawEndX; x += 4) {
+		__m128i xOffset = _mm_srai_epi32(xValues, 8);
+		__m128i yOffset = _mm_srai_epi32(yValues, 8);
+		xValues = _mm_add_epi32(xValues, xIncrement);
+		yValues = _mm_add_epi32(yValues, yIncrement);
+
+		//Pixels outside of the 1024x1024 map are only possible when LargeMap is set
+		__m128i inside = _mm_cmpeq_epi32(_mm_and_si128(_mm_or_si128(xOffset, yOffset), outsideMask), _mm_setzero_si128());
+		__m128i tilemapAddr = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(yOffset, tileRowMask), 4), _mm_srli_epi32(_mm_and_si128(xOffset, mapMask), 3));
+		__m128i chrOffset = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(yOffset, fineMask), 3), _mm_and_si128(xOffset, fineMask));
+
+		//All values fit in 16 bits: tilemap addresses in the first 4 words, CHR offsets in the last 4
+		alignas(16) uint16_t addr[8];
+		alignas(16) int16_t insideMap[8];
+		_mm_store_si128((__m128i*)addr, _mm_packs_epi32(tilemapAddr, chrOffset));
+		_mm_store_si128((__m128i*)insideMap, _mm_packs_epi32(inside, inside));
+
+		for(int i = 0; i < 4; i++) {
+			uint8_t tileIndex;
+			if(insideMap[i]) {
+				tileIndex = (uint8_t)_vram[addr[i]];
+			} else if(fillWithTile0) {
+				tileIndex = 0;
+			} else {
+				pixels[x + i] = Ppu::Mode7NoPixel;
+				continue;
+			}
+			pixels[x + i] = _vram[(tileIndex << 6) + addr[i + 4]] >> 8;
+		}
+	}
+
+	xValue += xStep * (x - _drawStartX);
+	yValue += yStep * (x - _drawStartX);
+#endif
+
+	FetchMode7PixelsScalar(xValue, yValue, xStep, yStep, pixels, x);
+}
+
+void Ppu::FetchMode7PixelsScalar(int32_t xValue, int32_t yValue, int16_t xStep, int16_t yStep, uint16_t *pixels, int startX)
+{
+	//Used for the pixels the SIMD loop can't process, this is also the reference it is tested against (Libretro/Mode7Compare)
+	for(int x = startX; x <= _drawEndX; x++) {
+		pixels[x] = GetMode7Pixel(xValue >> 8, yValue >> 8);
+		xValue += xStep;
+		yValue += yStep;
+	}
+}
+
 template<uint8_t layerIndex, uint8_t normalPriority, uint8_t highPriority, bool applyMosaic, bool directColorMode>
 void Ppu::RenderTilemapMode7()
 {
-	uint8_t mainWindowCount = _state.WindowMaskMain[layerIndex] ? (uint8_t)_state.Window[0].ActiveLayers[layerIndex] + (uint8_t)_state.Window[1].ActiveLayers[layerIndex] : 0;
-	uint8_t subWindowCount = _state.WindowMaskSub[layerIndex] ? (uint8_t)_state.Window[0].ActiveLayers[layerIndex] + (uint8_t)_state.Window[1].ActiveLayers[layerIndex] : 0;
+	bool mainWindowEnabled = _state.WindowMaskMain[layerIndex];
+	bool subWindowEnabled = _state.WindowMaskSub[layerIndex];
 	
 	bool drawMain = (bool)(((_state.MainScreenLayers & _configVisibleLayers) >> layerIndex) & 0x01);
 	bool drawSub = (bool)(((_state.SubScreenLayers & _configVisibleLayers) >> layerIndex) & 0x01);
@@ -1135,39 +1607,24 @@ void Ppu::RenderTilemapMode7()
 	
 	uint8_t pixelFlags = ((_state.ColorMathEnabled >> layerIndex) & 0x01) ? PixelFlags::AllowColorMath : 0;
 
-	for(int x = _drawStartX; x <= _drawEndX; x++) {
-		int32_t xOffset = xValue >> 8;
-		int32_t yOffset = yValue >> 8;
-		xValue += xStep;
-		yValue += yStep;
+	uint16_t pixels[256];
+	FetchMode7Pixels(xValue, yValue, xStep, yStep, pixels);
 
-		uint8_t tileIndex;
-		if(!_state.Mode7.LargeMap) {
-			yOffset &= 0x3FF;
-			xOffset &= 0x3FF;
-			tileIndex = (uint8_t)_vram[((yOffset & ~0x07) << 4) | (xOffset >> 3)];
-		} else {
-			if(yOffset < 0 || yOffset > 0x3FF || xOffset < 0 || xOffset > 0x3FF) {
-				if(_state.Mode7.FillWithTile0) {
-					tileIndex = 0;
-				} else {
-					//Draw nothing for this pixel, we're outside the map
-					continue;
-				}
-			} else {
-				tileIndex = (uint8_t)_vram[((yOffset & ~0x07) << 4) | (xOffset >> 3)];
-			}
+	for(int x = _drawStartX; x <= _drawEndX; x++) {
+		if(pixels[x] == Ppu::Mode7NoPixel) {
+			//Draw nothing for this pixel, we're outside the map
+			continue;
 		}
 
 		uint16_t colorIndex;
 		uint8_t priority;
 		if(layerIndex == 1) {
-			uint8_t color = _vram[((tileIndex << 6) + ((yOffset & 0x07) << 3) + (xOffset & 0x07))] >> 8;
+			uint8_t color = (uint8_t)pixels[x];
 			priority = (color & 0x80) ? highPriority : normalPriority;
 			colorIndex = (color & 0x7F);
 		} else {
 			priority = normalPriority;
-			colorIndex = _vram[((tileIndex << 6) + ((yOffset & 0x07) << 3) + (xOffset & 0x07))] >> 8;
+			colorIndex = pixels[x];
 		}
 
 		if(applyMosaic) {
@@ -1190,11 +1647,11 @@ void Ppu::RenderTilemapMode7()
 				paletteColor = _cgram[colorIndex];
 			}
 			
-			if(drawMain && (_mainScreenFlags[x] & 0x0F) < priority && !ProcessMaskWindow<layerIndex>(mainWindowCount, x)) {
+			if(drawMain && (_mainScreenFlags[x] & 0x0F) < priority && !ProcessMaskWindow<layerIndex>(mainWindowEnabled, x)) {
 				DrawMainPixel(x, paletteColor, priority | pixelFlags);
 			} 
 
-			if(drawSub && _subScreenPriority[x] < priority && !ProcessMaskWindow<layerIndex>(subWindowCount, x)) {
+			if(drawSub && _subScreenPriority[x] < priority && !ProcessMaskWindow<layerIndex>(subWindowEnabled, x)) {
 				DrawSubPixel(x, paletteColor, priority);
 			}
 		}
@@ -1215,33 +1672,52 @@ void Ppu::DrawSubPixel(uint8_t x, uint16_t color, uint8_t priority)
 
 void Ppu::ApplyColorMath()
 {
-	uint8_t activeWindowCount = (uint8_t)_state.Window[0].ActiveLayers[Ppu::ColorWindowIndex] + (uint8_t)_state.Window[1].ActiveLayers[Ppu::ColorWindowIndex];
 	bool hiResMode = _state.HiResMode || _state.BgMode == 5 || _state.BgMode == 6;
 
-	if(hiResMode) {
-		for(int x = _drawStartX; x <= _drawEndX; x++) {
-			bool isInsideWindow = ProcessMaskWindow<Ppu::ColorWindowIndex>(activeWindowCount, x);
+	//The operation done on a pixel only depends on 3 flags: calculate it for all 8 combinations, then process the pixels in bulk
+	uint8_t flagsLut[8];
+	for(int i = 0; i < 8; i++) {
+		flagsLut[i] = GetColorMathFlags((i & 0x01) != 0, (i & 0x02) != 0, (i & 0x04) != 0);
+	}
+
+	auto getPixelFlags = [this](int x) -> uint8_t {
+		return ((_mainScreenFlags[x] & PixelFlags::AllowColorMath) ? 0x02 : 0) | (_subScreenPriority[x] > 0 ? 0x04 : 0);
+	};
 
-			//Keep original subscreen color, which is used to apply color math to the main screen after
-			uint16_t subPixel = _subScreenBuffer[x];
-			//Apply the color math based on the previous main pixel
-			uint16_t prevMainPixel = x > 0 ? _mainScreenBuffer[x - 1] : 0;
-			int prevX = x > 0 ? x - 1 : 0;
-			ApplyColorMathToPixel(_subScreenBuffer[x], prevMainPixel, prevX, isInsideWindow);
+	uint8_t isInsideWindow[256];
+	uint8_t flags[256];
+	for(int x = _drawStartX; x <= _drawEndX; x++) {
+		isInsideWindow[x] = ProcessMaskWindow<Ppu::ColorWindowIndex>(true, x) ? 0x01 : 0;
+		flags[x] = flagsLut[isInsideWindow[x] | getPixelFlags(x)];
+	}
+
+#ifdef PPU_COLOR_MATH_CAPTURE
+	CaptureColorMathInput(_mainScreenBuffer, _subScreenBuffer, flags, _drawStartX, _drawEndX, _state.FixedColor, _state.ColorMathSubstractMode, _state.ScreenBrightness);
+#endif
+
+	//Main screen pixels use the original subscreen color, so process them before the subscreen pixels
+	ApplyColorMathToPixels(_mainScreenBuffer + _drawStartX, _subScreenBuffer + _drawStartX, flags + _drawStartX, _drawEndX - _drawStartX + 1);
 
-			ApplyColorMathToPixel(_mainScreenBuffer[x], subPixel, x, isInsideWindow);
+	if(hiResMode) {
+		//Apply the color math to the subscreen based on the previous main pixel (after color math was applied to it)
+		int x = _drawStartX;
+		if(x == 0) {
+			_subScreenBuffer[0] = ApplyColorMathToPixel(_subScreenBuffer[0], 0, flags[0]);
+			x++;
 		}
-	} else {
-		for(int x = _drawStartX; x <= _drawEndX; x++) {
-			bool isInsideWindow = ProcessMaskWindow<Ppu::ColorWindowIndex>(activeWindowCount, x);
-			ApplyColorMathToPixel(_mainScreenBuffer[x], _subScreenBuffer[x], x, isInsideWindow);
+
+		if(x <= _drawEndX) {
+			for(int i = x; i <= _drawEndX; i++) {
+				flags[i] = flagsLut[isInsideWindow[i] | getPixelFlags(i - 1)];
+			}
+			ApplyColorMathToPixels(_subScreenBuffer + x, _mainScreenBuffer + x - 1, flags + x, _drawEndX - x + 1);
 		}
 	}
 }
 
-void Ppu::ApplyColorMathToPixel(uint16_t &pixelA, uint16_t pixelB, int x, bool isInsideWindow)
+uint8_t Ppu::GetColorMathFlags(bool isInsideWindow, bool allowColorMath, bool hasSubScreenPixel)
 {
-	uint8_t halfShift = (uint8_t)_state.ColorMathHalveResult;
+	uint8_t flags = _state.ColorMathHalveResult ? ColorMathFlags::HalveResult : 0;
 
 	//Set color to black as needed based on clip mode
 	switch(_state.ColorMathClipMode) {
@@ -1250,24 +1726,22 @@ void Ppu::ApplyColorMathToPixel(uint16_t &pixelA, uint16_t pixelB, int x, bool i
 
 		case ColorWindowMode::OutsideWindow:
 			if(!isInsideWindow) {
-				pixelA = 0;
-				halfShift = 0;
+				flags = ColorMathFlags::ClipToBlack;
 			}
 			break;
 
 		case ColorWindowMode::InsideWindow:
 			if(isInsideWindow) {
-				pixelA = 0;
-				halfShift = 0;
+				flags = ColorMathFlags::ClipToBlack;
 			}
 			break;
 
-		case ColorWindowMode::Always: pixelA = 0; break;
+		case ColorWindowMode::Always: flags |= ColorMathFlags::ClipToBlack; break;
 	}
 
-	if(!(_mainScreenFlags[x] & PixelFlags::AllowColorMath)) {
+	if(!allowColorMath) {
 		//Color math doesn't apply to this pixel
-		return;
+		return flags;
 	}
 
 	//Prevent color math as needed based on mode
@@ -1277,45 +1751,188 @@ void Ppu::ApplyColorMathToPixel(uint16_t &pixelA, uint16_t pixelB, int x, bool i
 
 		case ColorWindowMode::OutsideWindow:
 			if(!isInsideWindow) {
-				return;
+				return flags;
 			}
 			break;
 
 		case ColorWindowMode::InsideWindow:
 			if(isInsideWindow) {
-				return;
+				return flags;
 			}
 			break;
 
-		case ColorWindowMode::Always: return;
+		case ColorWindowMode::Always: return flags;
 	}
 
-	uint16_t otherPixel;
+	flags |= ColorMathFlags::ApplyColorMath;
 	if(_state.ColorMathAddSubscreen) {
-		if(_subScreenPriority[x] > 0) {
-			otherPixel = pixelB;
+		if(hasSubScreenPixel) {
+			flags |= ColorMathFlags::UseSubScreen;
 		} else {
 			//there's nothing in the subscreen at this pixel, use the fixed color and disable halve operation
-			otherPixel = _state.FixedColor;
-			halfShift = 0;
+			flags &= ~ColorMathFlags::HalveResult;
 		}
-	} else {
-		otherPixel = _state.FixedColor;
+	}
+	return flags;
+}
+
+uint16_t Ppu::ApplyColorMathToPixel(uint16_t pixelA, uint16_t pixelB, uint8_t flags)
+{
+	if(flags & ColorMathFlags::ClipToBlack) {
+		pixelA = 0;
+	}
+
+	if(!(flags & ColorMathFlags::ApplyColorMath)) {
+		return pixelA;
 	}
 
+	uint16_t otherPixel = (flags & ColorMathFlags::UseSubScreen) ? pixelB : _state.FixedColor;
+	uint8_t halfShift = (flags & ColorMathFlags::HalveResult) ? 1 : 0;
+
 	constexpr unsigned int mask = 0x1F;
 	if(_state.ColorMathSubstractMode) {
 		uint16_t r = std::max((int)((pixelA & mask) - (otherPixel & mask)), 0) >> halfShift;
 		uint16_t g = std::max((int)(((pixelA >> 5U) & mask) - ((otherPixel >> 5U) & mask)), 0) >> halfShift;
 		uint16_t b = std::max((int)(((pixelA >> 10U) & mask) - ((otherPixel >> 10U) & mask)), 0) >> halfShift;
 
-		pixelA = r | (g << 5U) | (b << 10U);
+		return r | (g << 5U) | (b << 10U);
 	} else {
 		uint16_t r = std::min(((pixelA & mask) + (otherPixel & mask)) >> halfShift, mask);
 		uint16_t g = std::min((((pixelA >> 5U) & mask) + ((otherPixel >> 5U) & mask)) >> halfShift, mask);
 		uint16_t b = std::min((((pixelA >> 10U) & mask) + ((otherPixel >> 10U) & mask)) >> halfShift, mask);
 
-		pixelA = r | (g << 5U) | (b << 10U);
+		return r | (g << 5U) | (b << 10U);
+	}
+}
+
+#ifdef PPU_USE_SSE2
+template<int shift>
+static __forceinline __m128i ApplyColorMathToChannel(__m128i pixelA, __m128i pixelB, __m128i halve, bool subtract)
+{
+	const __m128i mask = _mm_set1_epi16(0x1F);
+	__m128i a = _mm_and_si128(_mm_srli_epi16(pixelA, shift), mask);
+	__m128i b = _mm_and_si128(_mm_srli_epi16(pixelB, shift), mask);
+
+	//Unsigned saturation clamps the result of the subtraction to 0
+	__m128i result = subtract ? _mm_subs_epu16(a, b) : _mm_add_epi16(a, b);
+	result = _mm_or_si128(_mm_and_si128(halve, _mm_srli_epi16(result, 1)), _mm_andnot_si128(halve, result));
+	if(!subtract) {
+		result = _mm_min_epi16(result, mask);
+	}
+	return _mm_slli_epi16(result, shift);
+}
+
+static __forceinline __m128i GetFlagMask(__m128i flags, uint8_t flag)
+{
+	const __m128i flagValue = _mm_set1_epi16(flag);
+	return _mm_cmpeq_epi16(_mm_and_si128(flags, flagValue), flagValue);
+}
+#endif
+
+#ifdef PPU_USE_AVX2
+template<int shift>
+__attribute__((target("avx2"))) static __forceinline __m256i ApplyColorMathToChannelAvx2(__m256i pixelA, __m256i pixelB, __m256i halve, bool subtract)
+{
+	const __m256i mask = _mm256_set1_epi16(0x1F);
+	__m256i a = _mm256_and_si256(_mm256_srli_epi16(pixelA, shift), mask);
+	__m256i b = _mm256_and_si256(_mm256_srli_epi16(pixelB, shift), mask);
+
+	__m256i result = subtract ? _mm256_subs_epu16(a, b) : _mm256_add_epi16(a, b);
+	result = _mm256_blendv_epi8(result, _mm256_srli_epi16(result, 1), halve);
+	if(!subtract) {
+		result = _mm256_min_epi16(result, mask);
+	}
+	return _mm256_slli_epi16(result, shift);
+}
+
+__attribute__((target("avx2"))) static __forceinline __m256i GetFlagMaskAvx2(__m256i flags, uint8_t flag)
+{
+	const __m256i flagValue = _mm256_set1_epi16(flag);
+	return _mm256_cmpeq_epi16(_mm256_and_si256(flags, flagValue), flagValue);
+}
+
+//Same as the SSE2 loop in ApplyColorMathToPixels, for 16 pixels at a time - returns the number of pixels processed
+__attribute__((target("avx2"))) static int ApplyColorMathToPixelsAvx2(uint16_t *pixels, const uint16_t *otherPixels, const uint8_t *flags, int count, uint16_t fixedColorValue, bool subtract)
+{
+	const __m256i fixedColor = _mm256_set1_epi16((int16_t)fixedColorValue);
+
+	int i = 0;
+	for(; i + 16 <= count; i += 16) {
+		__m256i pixelFlags = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(flags + i)));
+		__m256i clip = GetFlagMaskAvx2(pixelFlags, ColorMathFlags::ClipToBlack);
+		__m256i apply = GetFlagMaskAvx2(pixelFlags, ColorMathFlags::ApplyColorMath);
+		__m256i halve = GetFlagMaskAvx2(pixelFlags, ColorMathFlags::HalveResult);
+		__m256i useSubScreen = GetFlagMaskAvx2(pixelFlags, ColorMathFlags::UseSubScreen);
+
+		__m256i pixelA = _mm256_andnot_si256(clip, _mm256_loadu_si256((const __m256i*)(pixels + i)));
+		__m256i pixelB = _mm256_blendv_epi8(fixedColor, _mm256_loadu_si256((const __m256i*)(otherPixels + i)), useSubScreen);
+
+		__m256i result = _mm256_or_si256(
+			_mm256_or_si256(ApplyColorMathToChannelAvx2<0>(pixelA, pixelB, halve, subtract), ApplyColorMathToChannelAvx2<5>(pixelA, pixelB, halve, subtract)),
+			ApplyColorMathToChannelAvx2<10>(pixelA, pixelB, halve, subtract)
+		);
+		_mm256_storeu_si256((__m256i*)(pixels + i), _mm256_blendv_epi8(pixelA, result, apply));
+	}
+	return i;
+}
+
+//Same as the SSE2 loop in ApplyBrightness, for 16 pixels at a time - returns the number of pixels processed
+__attribute__((target("avx2"))) static int ApplyBrightnessAvx2(uint16_t *pixels, int count, uint8_t screenBrightness)
+{
+	const __m256i mask = _mm256_set1_epi16(0x1F);
+	const __m256i brightness = _mm256_set1_epi16(screenBrightness);
+	const __m256i divideBy15 = _mm256_set1_epi16((int16_t)0x8889);
+
+	int i = 0;
+	for(; i + 16 <= count; i += 16) {
+		__m256i pixel = _mm256_loadu_si256((const __m256i*)(pixels + i));
+		__m256i r = _mm256_srli_epi16(_mm256_mulhi_epu16(_mm256_mullo_epi16(_mm256_and_si256(pixel, mask), brightness), divideBy15), 3);
+		__m256i g = _mm256_srli_epi16(_mm256_mulhi_epu16(_mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi16(pixel, 5), mask), brightness), divideBy15), 3);
+		__m256i b = _mm256_srli_epi16(_mm256_mulhi_epu16(_mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi16(pixel, 10), mask), brightness), divideBy15), 3);
+		_mm256_storeu_si256((__m256i*)(pixels + i), _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi16(g, 5)), _mm256_slli_epi16(b, 10)));
+	}
+	return i;
+}
+#endif
+
+void Ppu::ApplyColorMathToPixels(uint16_t *pixels, const uint16_t *otherPixels, const uint8_t *flags, int count)
+{
+	int i = 0;
+
+#ifdef PPU_USE_AVX2
+	if(_useAvx2) {
+		i = ApplyColorMathToPixelsAvx2(pixels, otherPixels, flags, count, _state.FixedColor, _state.ColorMathSubstractMode);
+	}
+#endif
+
+#ifdef PPU_USE_SSE2
+	if(_useSse2) {
+		const __m128i fixedColor = _mm_set1_epi16((int16_t)_state.FixedColor);
+		bool subtract = _state.ColorMathSubstractMode;
+
+		for(; i + 8 <= count; i += 8) {
+			__m128i pixelFlags = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(flags + i)), _mm_setzero_si128());
+			__m128i clip = GetFlagMask(pixelFlags, ColorMathFlags::ClipToBlack);
+			__m128i apply = GetFlagMask(pixelFlags, ColorMathFlags::ApplyColorMath);
+			__m128i halve = GetFlagMask(pixelFlags, ColorMathFlags::HalveResult);
+			__m128i useSubScreen = GetFlagMask(pixelFlags, ColorMathFlags::UseSubScreen);
+
+			__m128i pixelA = _mm_andnot_si128(clip, _mm_loadu_si128((const __m128i*)(pixels + i)));
+			__m128i pixelB = _mm_loadu_si128((const __m128i*)(otherPixels + i));
+			pixelB = _mm_or_si128(_mm_and_si128(useSubScreen, pixelB), _mm_andnot_si128(useSubScreen, fixedColor));
+
+			__m128i result = _mm_or_si128(
+				_mm_or_si128(ApplyColorMathToChannel<0>(pixelA, pixelB, halve, subtract), ApplyColorMathToChannel<5>(pixelA, pixelB, halve, subtract)),
+				ApplyColorMathToChannel<10>(pixelA, pixelB, halve, subtract)
+			);
+			result = _mm_or_si128(_mm_and_si128(apply, result), _mm_andnot_si128(apply, pixelA));
+			_mm_storeu_si128((__m128i*)(pixels + i), result);
+		}
+	}
+#endif
+
+	for(; i < count; i++) {
+		pixels[i] = ApplyColorMathToPixel(pixels[i], otherPixels[i], flags[i]);
 	}
 }
 
@@ -1323,8 +1940,33 @@ template<bool forMainScreen>
 void Ppu::ApplyBrightness()
 {
 	if(_state.ScreenBrightness != 15) {
-		for(int x = _drawStartX; x <= _drawEndX; x++) {
-			uint16_t &pixel = (forMainScreen ? _mainScreenBuffer : _subScreenBuffer)[x];
+		uint16_t* buffer = forMainScreen ? _mainScreenBuffer : _subScreenBuffer;
+		int x = _drawStartX;
+
+#ifdef PPU_USE_AVX2
+		if(_useAvx2) {
+			x += ApplyBrightnessAvx2(buffer + x, _drawEndX - x + 1, _state.ScreenBrightness);
+		}
+#endif
+
+#ifdef PPU_USE_SSE2
+		if(_useSse2) {
+			//(value * 0x8889) >> 19 is equal to value / 15 for all values that can occur here (0 to 31*14)
+			const __m128i mask = _mm_set1_epi16(0x1F);
+			const __m128i brightness = _mm_set1_epi16(_state.ScreenBrightness);
+			const __m128i divideBy15 = _mm_set1_epi16((int16_t)0x8889);
+			for(; x + 7 <= _drawEndX; x += 8) {
+				__m128i pixel = _mm_loadu_si128((const __m128i*)(buffer + x));
+				__m128i r = _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(_mm_and_si128(pixel, mask), brightness), divideBy15), 3);
+				__m128i g = _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(pixel, 5), mask), brightness), divideBy15), 3);
+				__m128i b = _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(pixel, 10), mask), brightness), divideBy15), 3);
+				_mm_storeu_si128((__m128i*)(buffer + x), _mm_or_si128(_mm_or_si128(r, _mm_slli_epi16(g, 5)), _mm_slli_epi16(b, 10)));
+			}
+		}
+#endif
+
+		for(; x <= _drawEndX; x++) {
+			uint16_t &pixel = buffer[x];
 			uint16_t r = (pixel & 0x1F) * _state.ScreenBrightness / 15;
 			uint16_t g = ((pixel >> 5) & 0x1F) * _state.ScreenBrightness / 15;
 			uint16_t b = ((pixel >> 10) & 0x1F) * _state.ScreenBrightness / 15;
@@ -1341,6 +1983,8 @@ void Ppu::ConvertToHiRes()
 	}
 
 	//Convert standard res picture to high resolution when the PPU starts drawing in high res mid frame
+	WaitForRenderThread();
+	InvalidateLineHashes(_currentBuffer);
 	_useHighResOutput = useHighResOutput;
 
 	uint16_t scanline = _overscanFrame ? (_scanline - 1) : (_scanline + 6);
@@ -1370,21 +2014,14 @@ void Ppu::ApplyHiResMode()
 	if(!_useHighResOutput) {
 		memcpy(_currentBuffer + (scanline << 8) + _drawStartX, _mainScreenBuffer + _drawStartX, (_drawEndX - _drawStartX + 1) << 1);
 	} else {
-		_interlacedFrame |= _state.ScreenInterlace;
 		uint32_t screenY = _state.ScreenInterlace ? (_oddFrame ? ((scanline << 1) + 1) : (scanline << 1)) : (scanline << 1);
 		uint32_t baseAddr = (screenY << 9);
 
 		if(IsDoubleWidth()) {
 			ApplyBrightness<false>();
-			for(int x = _drawStartX; x <= _drawEndX; x++) {
-				_currentBuffer[baseAddr + (x << 1)] = _subScreenBuffer[x];
-				_currentBuffer[baseAddr + (x << 1) + 1] = _mainScreenBuffer[x];
-			}
+			WriteHiResPixels(_currentBuffer + baseAddr, _subScreenBuffer, _mainScreenBuffer);
 		} else {
-			for(int x = _drawStartX; x <= _drawEndX; x++) {
-				_currentBuffer[baseAddr + (x << 1)] = _mainScreenBuffer[x];
-				_currentBuffer[baseAddr + (x << 1) + 1] = _mainScreenBuffer[x];
-			}
+			WriteHiResPixels(_currentBuffer + baseAddr, _mainScreenBuffer, _mainScreenBuffer);
 		}
 
 		if(!_state.ScreenInterlace) {
@@ -1398,30 +2035,77 @@ void Ppu::ApplyHiResMode()
 	}
 }
 
+void Ppu::WriteHiResPixels(uint16_t *out, const uint16_t *evenPixels, const uint16_t *oddPixels)
+{
+	//Interleave the 2 sources into the 512-pixel wide output (subscreen/main screen for pseudo hi-res, or main screen twice)
+	int x = _drawStartX;
+
+#ifdef PPU_USE_SSE2
+	for(; x + 7 <= _drawEndX; x += 8) {
+		__m128i even = _mm_loadu_si128((const __m128i*)(evenPixels + x));
+		__m128i odd = _mm_loadu_si128((const __m128i*)(oddPixels + x));
+		_mm_storeu_si128((__m128i*)(out + (x << 1)), _mm_unpacklo_epi16(even, odd));
+		_mm_storeu_si128((__m128i*)(out + (x << 1) + 8), _mm_unpackhi_epi16(even, odd));
+	}
+#endif
+
+	for(; x <= _drawEndX; x++) {
+		out[x << 1] = evenPixels[x];
+		out[(x << 1) + 1] = oddPixels[x];
+	}
+}
+
 template<uint8_t layerIndex>
-bool Ppu::ProcessMaskWindow(uint8_t activeWindowCount, int x)
+bool Ppu::ProcessMaskWindow(bool windowEnabled, int x)
 {
-	switch(activeWindowCount) {
-		case 1: 
-			if(_state.Window[0].ActiveLayers[layerIndex]) {
-				return _state.Window[0].PixelNeedsMasking<layerIndex>(x);
-			}
-			return _state.Window[1].PixelNeedsMasking<layerIndex>(x);
+	return windowEnabled && ((_windowMask[layerIndex][x >> 6] >> (x & 0x3F)) & 0x01);
+}
+
+void Ppu::UpdateWindowMasks()
+{
+	//Get the pixels between the left and right positions of both windows (none when left > right)
+	uint64_t windowPixels[2][4];
+	for(int i = 0; i < 2; i++) {
+		for(int j = 0; j < 4; j++) {
+			int start = std::max<int>(_state.Window[i].Left, j << 6);
+			int end = std::min<int>(_state.Window[i].Right, (j << 6) + 63);
+			windowPixels[i][j] = start <= end ? ((~0ULL >> (63 - (end - start))) << (start & 0x3F)) : 0;
+		}
+	}
 
-		case 2:
-			switch(_state.MaskLogic[layerIndex]) {
-				default:
-				case WindowMaskLogic::Or: return _state.Window[0].PixelNeedsMasking<layerIndex>(x) | _state.Window[1].PixelNeedsMasking<layerIndex>(x);
-				case WindowMaskLogic::And: return _state.Window[0].PixelNeedsMasking<layerIndex>(x) & _state.Window[1].PixelNeedsMasking<layerIndex>(x);
-				case WindowMaskLogic::Xor: return _state.Window[0].PixelNeedsMasking<layerIndex>(x) ^ _state.Window[1].PixelNeedsMasking<layerIndex>(x);
-				case WindowMaskLogic::Xnor: return !(_state.Window[0].PixelNeedsMasking<layerIndex>(x) ^ _state.Window[1].PixelNeedsMasking<layerIndex>(x));
+	for(int layer = 0; layer < 6; layer++) {
+		bool window1Active = _state.Window[0].ActiveLayers[layer];
+		bool window2Active = _state.Window[1].ActiveLayers[layer];
+
+		for(int j = 0; j < 4; j++) {
+			uint64_t window1 = _state.Window[0].InvertedLayers[layer] ? ~windowPixels[0][j] : windowPixels[0][j];
+			uint64_t window2 = _state.Window[1].InvertedLayers[layer] ? ~windowPixels[1][j] : windowPixels[1][j];
+
+			uint64_t mask = 0;
+			if(window1Active && window2Active) {
+				switch(_state.MaskLogic[layer]) {
+					default:
+					case WindowMaskLogic::Or: mask = window1 | window2; break;
+					case WindowMaskLogic::And: mask = window1 & window2; break;
+					case WindowMaskLogic::Xor: mask = window1 ^ window2; break;
+					case WindowMaskLogic::Xnor: mask = ~(window1 ^ window2); break;
+				}
+			} else if(window1Active) {
+				mask = window1;
+			} else if(window2Active) {
+				mask = window2;
 			}
+			_windowMask[layer][j] = mask;
+		}
 	}
-	return false;
+
+	_windowMaskDirty = false;
 }
 
 void Ppu::ProcessWindowMaskSettings(uint8_t value, uint8_t offset)
 {
+	_windowMaskDirty = true;
+
 	_state.Window[0].ActiveLayers[0 + offset] = (value & 0x02) != 0;
 	_state.Window[0].ActiveLayers[1 + offset] = (value & 0x20) != 0;
 	_state.Window[0].InvertedLayers[0 + offset] = (value & 0x01) != 0;
@@ -1444,14 +2128,29 @@ void Ppu::SendFrame()
 		int bottom = (_useHighResOutput ? 16 : 8);
 		memset(_currentBuffer, 0, width * top * sizeof(uint16_t));
 		memset(_currentBuffer + width * (height - bottom), 0, width * bottom * sizeof(uint16_t));
+
+		//Lines drawn (or copied) into the cleared rows are gone
+		uint8_t bufferIndex = _currentBuffer == _outputBuffers[0] ? 0 : 1;
+		memset(_lineHashes[bufferIndex], 0, 8 * sizeof(uint64_t));
+		memset(_lineHashes[bufferIndex] + 225, 0, (256 - 225) * sizeof(uint64_t));
 	}
 
 	_console->GetNotificationManager()->SendNotification(ConsoleNotificationType::PpuFrameDone);
 
+	if(_settings->CheckFlag(EmulationFlags::Headless)) {
+		//Nothing needs to be decoded or displayed
+		return;
+	}
+
 	bool isRewinding = _console->GetRewindManager()->IsRewinding();
 
 #ifdef LIBRETRO
-	_console->GetVideoDecoder()->UpdateFrameSync(_currentBuffer, width, height, _frameCount, isRewinding);
+	//Interlaced frames are drawn over the same buffer, so they can't be decoded while the next frame runs
+	if(_settings->GetVideoConfig().EnablePipelinedDecode && !isRewinding && !_interlacedFrame) {
+		_console->GetVideoDecoder()->UpdateFramePipelined(_currentBuffer, width, height, _frameCount);
+	} else {
+		_console->GetVideoDecoder()->UpdateFrameSync(_currentBuffer, width, height, _frameCount, isRewinding);
+	}
 #else
 	if(isRewinding || _interlacedFrame) {
 		_console->GetVideoDecoder()->UpdateFrameSync(_currentBuffer, width, height, _frameCount, isRewinding);
@@ -1560,6 +2259,108 @@ void Ppu::UpdateVramReadBuffer()
 	_state.VramReadBuffer = _vram[addr];
 }
 
+void Ppu::WriteOamData(uint8_t value)
+{
+	//When trying to read/write during rendering, the internal address used by the PPU's sprite rendering is used
+	//This is approximated by _oamRenderAddress (but is not cycle accurate) - needed for Uniracers
+	uint16_t oamAddr = GetOamAddress();
+	
+	if(oamAddr < 512) {
+		if(oamAddr & 0x01) {
+			_console->ProcessPpuWrite(oamAddr - 1, _oamWriteBuffer, SnesMemoryType::SpriteRam);
+			_oamRam[oamAddr - 1] = _oamWriteBuffer;
+
+			_console->ProcessPpuWrite(oamAddr, value, SnesMemoryType::SpriteRam);
+			_oamRam[oamAddr] = value;
+			_scanlineSpritesDirty = true;
+		} else {
+			_oamWriteBuffer = value;
+		}
+	} 
+
+	if(!_state.ForcedVblank && _scanline < _nmiScanline) {
+		//During rendering the high table is also written to when writing to OAM
+		oamAddr = 0x200 | ((oamAddr & 0x1F0) >> 4);
+	}
+	
+	if(oamAddr >= 512) {
+		uint16_t address = 0x200 | (oamAddr & 0x1F);
+		if((oamAddr & 0x01) == 0) {
+			_oamWriteBuffer = value;
+		}
+		_console->ProcessPpuWrite(address, value, SnesMemoryType::SpriteRam);
+		_oamRam[address] = value;
+		_scanlineSpritesDirty = true;
+	}
+	_internalOamAddress = (_internalOamAddress + 1) & 0x3FF;
+}
+
+void Ppu::WriteVramData(uint8_t value, bool highByte)
+{
+	if(_scanline >= _nmiScanline || _state.ForcedVblank) {
+		//Only write the value if in vblank or forced blank (writes to VRAM outside vblank/forced blank are not allowed)
+		uint16_t addr = GetVramAddress();
+		if(highByte) {
+			_console->ProcessPpuWrite((addr << 1) + 1, value, SnesMemoryType::VideoRam);
+			_vram[addr] = (value << 8) | (_vram[addr] & 0xFF);
+		} else {
+			_console->ProcessPpuWrite(addr << 1, value, SnesMemoryType::VideoRam);
+			_vram[addr] = value | (_vram[addr] & 0xFF00);
+		}
+		InvalidateTileCache(addr);
+	}
+
+	//The VRAM address is incremented even outside of vblank/forced blank
+	if(_state.VramAddrIncrementOnSecondReg == highByte) {
+		_state.VramAddress = (_state.VramAddress + _state.VramIncrementValue) & 0x7FFF;
+	}
+}
+
+void Ppu::WriteCgramData(uint8_t value)
+{
+	if(_state.CgramAddressLatch) {
+		//MSB ignores the 7th bit (colors are 15-bit only)
+		_console->ProcessPpuWrite(_state.CgramAddress >> 1, _state.CgramWriteBuffer, SnesMemoryType::CGRam);
+		_console->ProcessPpuWrite((_state.CgramAddress >> 1) + 1, value & 0x7F, SnesMemoryType::CGRam);
+
+		_cgram[_state.CgramAddress] = _state.CgramWriteBuffer | ((value & 0x7F) << 8);
+		_state.CgramAddress++;
+	} else {
+		_state.CgramWriteBuffer = value;
+	}
+	_state.CgramAddressLatch = !_state.CgramAddressLatch;
+}
+
+bool Ppu::CanWriteDmaBlock()
+{
+	if(_scanline >= _vblankStartScanline) {
+		//Nothing is rendered during vblank
+		return true;
+	}
+
+	if(!_state.ForcedVblank) {
+		return false;
+	}
+
+	//During forced blank, rendering only reads OAM/VRAM to fetch sprites that were found before forced blank was enabled.
+	//Catch up to the current cycle (like the block's first write would) and make sure no sprites are left to fetch.
+	RenderScanline();
+	return _spriteCount == 0;
+}
+
+void Ppu::WriteDmaBlock(uint8_t destAddress, const uint8_t *destOffsets, uint8_t offsetIndex, const uint8_t *data, uint16_t length)
+{
+	//Same result as calling Write() for each byte, as long as CanWriteDmaBlock() is true and only the OAM/VRAM/CGRAM data ports are targeted
+	for(uint16_t i = 0; i < length; i++) {
+		switch((uint8_t)(destAddress + destOffsets[(offsetIndex + i) & 0x03])) {
+			case 0x04: WriteOamData(data[i]); break;
+			case 0x18: WriteVramData(data[i], false); break;
+			case 0x19: WriteVramData(data[i], true); break;
+			case 0x22: WriteCgramData(data[i]); break;
+		}
+	}
+}
+
 uint16_t Ppu::GetVramAddress()
 {
 	uint16_t addr = _state.VramAddress;
@@ -1759,6 +2560,7 @@ void Ppu::Write(uint32_t addr, uint8_t value)
 
 		case 0x2101:
 			_state.OamMode = (value & 0xE0) >> 5;
+			_scanlineSpritesDirty = true;
 			_state.OamBaseAddress = (value & 0x07) << 13;
 			_state.OamAddressOffset = (((value & 0x18) >> 3) + 1) << 12;
 			break;
@@ -1774,39 +2576,9 @@ void Ppu::Write(uint32_t addr, uint8_t value)
 			_state.EnableOamPriority = (value & 0x80) != 0;
 			break;
 
-		case 0x2104: {
-			//When trying to read/write during rendering, the internal address used by the PPU's sprite rendering is used
-			//This is approximated by _oamRenderAddress (but is not cycle accurate) - needed for Uniracers
-			uint16_t oamAddr = GetOamAddress();
-			
-			if(oamAddr < 512) {
-				if(oamAddr & 0x01) {
-					_console->ProcessPpuWrite(oamAddr - 1, _oamWriteBuffer, SnesMemoryType::SpriteRam);
-					_oamRam[oamAddr - 1] = _oamWriteBuffer;
-	
-					_console->ProcessPpuWrite(oamAddr, value, SnesMemoryType::SpriteRam);
-					_oamRam[oamAddr] = value;
-				} else {
-					_oamWriteBuffer = value;
-				}
-			} 
-
-			if(!_state.ForcedVblank && _scanline < _nmiScanline) {
-				//During rendering the high table is also written to when writing to OAM
-				oamAddr = 0x200 | ((oamAddr & 0x1F0) >> 4);
-			}
-			
-			if(oamAddr >= 512) {
-				uint16_t address = 0x200 | (oamAddr & 0x1F);
-				if((oamAddr & 0x01) == 0) {
-					_oamWriteBuffer = value;
-				}
-				_console->ProcessPpuWrite(address, value, SnesMemoryType::SpriteRam);
-				_oamRam[address] = value;
-			}
-			_internalOamAddress = (_internalOamAddress + 1) & 0x3FF;
+		case 0x2104:
+			WriteOamData(value);
 			break;
-		}
 
 		case 0x2105:
 			if(_state.BgMode != (value & 0x07)) {
@@ -1905,30 +2677,12 @@ void Ppu::Write(uint32_t addr, uint8_t value)
 
 		case 0x2118:
 			//VMDATAL - VRAM Data Write low byte
-			if(_scanline >= _nmiScanline || _state.ForcedVblank) {
-				//Only write the value if in vblank or forced blank (writes to VRAM outside vblank/forced blank are not allowed)
-				_console->ProcessPpuWrite(GetVramAddress() << 1, value, SnesMemoryType::VideoRam);
-				_vram[GetVramAddress()] = value | (_vram[GetVramAddress()] & 0xFF00);
-			}
-
-			//The VRAM address is incremented even outside of vblank/forced blank
-			if(!_state.VramAddrIncrementOnSecondReg) {
-				_state.VramAddress = (_state.VramAddress + _state.VramIncrementValue) & 0x7FFF;
-			}
+			WriteVramData(value, false);
 			break;
 
 		case 0x2119:
 			//VMDATAH - VRAM Data Write high byte
-			if(_scanline >= _nmiScanline || _state.ForcedVblank) {
-				//Only write the value if in vblank or forced blank (writes to VRAM outside vblank/forced blank are not allowed)
-				_console->ProcessPpuWrite((GetVramAddress() << 1) + 1, value, SnesMemoryType::VideoRam);
-				_vram[GetVramAddress()] = (value << 8) | (_vram[GetVramAddress()] & 0xFF); 
-			}
-			
-			//The VRAM address is incremented even outside of vblank/forced blank
-			if(_state.VramAddrIncrementOnSecondReg) {
-				_state.VramAddress = (_state.VramAddress + _state.VramIncrementValue) & 0x7FFF;
-			}
+			WriteVramData(value, true);
 			break;
 
 		case 0x211A:
@@ -1965,17 +2719,7 @@ void Ppu::Write(uint32_t addr, uint8_t value)
 
 		case 0x2122: 
 			//CGRAM Data write (CGDATA)
-			if(_state.CgramAddressLatch) {
-				//MSB ignores the 7th bit (colors are 15-bit only)
-				_console->ProcessPpuWrite(_state.CgramAddress >> 1, _state.CgramWriteBuffer, SnesMemoryType::CGRam);
-				_console->ProcessPpuWrite((_state.CgramAddress >> 1) + 1, value & 0x7F, SnesMemoryType::CGRam);
-
-				_cgram[_state.CgramAddress] = _state.CgramWriteBuffer | ((value & 0x7F) << 8);
-				_state.CgramAddress++;
-			} else {
-				_state.CgramWriteBuffer = value;
-			}
-			_state.CgramAddressLatch = !_state.CgramAddressLatch;
+			WriteCgramData(value);
 			break;
 
 		case 0x2123:
@@ -1996,21 +2740,25 @@ void Ppu::Write(uint32_t addr, uint8_t value)
 		case 0x2126:
 			//WH0 - Window 1 Left Position
 			_state.Window[0].Left = value;
+			_windowMaskDirty = true;
 			break;
 		
 		case 0x2127:
 			//WH1 - Window 1 Right Position
 			_state.Window[0].Right = value;
+			_windowMaskDirty = true;
 			break;
 
 		case 0x2128:
 			//WH2 - Window 2 Left Position
 			_state.Window[1].Left = value;
+			_windowMaskDirty = true;
 			break;
 
 		case 0x2129:
 			//WH3 - Window 2 Right Position
 			_state.Window[1].Right = value;
+			_windowMaskDirty = true;
 			break;
 
 		case 0x212A:
@@ -2019,12 +2767,14 @@ void Ppu::Write(uint32_t addr, uint8_t value)
 			_state.MaskLogic[1] = (WindowMaskLogic)((value >> 2) & 0x03);
 			_state.MaskLogic[2] = (WindowMaskLogic)((value >> 4) & 0x03);
 			_state.MaskLogic[3] = (WindowMaskLogic)((value >> 6) & 0x03);
+			_windowMaskDirty = true;
 			break;
 
 		case 0x212B:
 			//WOBJLOG - Window mask logic for OBJs and Color Window
 			_state.MaskLogic[4] = (WindowMaskLogic)((value >> 0) & 0x03);
 			_state.MaskLogic[5] = (WindowMaskLogic)((value >> 2) & 0x03);
+			_windowMaskDirty = true;
 			break;
 
 		case 0x212C:
@@ -2086,6 +2836,7 @@ void Ppu::Write(uint32_t addr, uint8_t value)
 			_state.HiResMode = (value & 0x08) != 0;
 			_state.OverscanMode = (value & 0x04) != 0;
 			_state.ObjInterlace = (value & 0x02) != 0;
+			_scanlineSpritesDirty = true;
 
 			bool interlace = (value & 0x01) != 0;
 			if(_state.ScreenInterlace != interlace) {
@@ -2093,6 +2844,7 @@ void Ppu::Write(uint32_t addr, uint8_t value)
 				if(_scanline >= _vblankStartScanline && interlace) {
 					//Clear buffer when turning on interlace mode during vblank
 					memset(GetPreviousScreenBuffer(), 0, 512 * 478 * sizeof(uint16_t));
+					InvalidateLineHashes(GetPreviousScreenBuffer());
 				}
 			}
 			ConvertToHiRes();
@@ -2107,6 +2859,8 @@ void Ppu::Write(uint32_t addr, uint8_t value)
 
 void Ppu::Serialize(Serializer &s)
 {
+	WaitForRenderThread();
+
 	uint16_t unused_oamRenderAddress = 0;
 	s.Stream(
 		_state.ForcedVblank, _state.ScreenBrightness, _scanline, _frameCount, _drawStartX, _drawEndX, _state.BgMode,
@@ -2154,6 +2908,20 @@ void Ppu::Serialize(Serializer &s)
 			);
 		}
 	}
+
+	if(!s.IsSaving()) {
+		//The decoded pixels aren't saved, use the CHR data for the remainder of the current scanline
+		for(int i = 0; i < 4; i++) {
+			for(int j = 0; j < 33; j++) {
+				_layerData[i].Tiles[j].PixelsBpp[0] = 0;
+				_layerData[i].Tiles[j].PixelsBpp[1] = 0;
+			}
+		}
+		InvalidateTileCache();
+		_windowMaskDirty = true;
+		_scanlineSpritesDirty = true;
+		memset(_lineHashes, 0, sizeof(_lineHashes));
+	}
 	s.Stream(_hOffset, _vOffset, _fetchBgStart, _fetchBgEnd, _fetchSpriteStart, _fetchSpriteEnd);
 }
 
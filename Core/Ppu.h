@@ -9,9 +9,15 @@ class InternalRegisters;
 class MemoryManager;
 class Spc;
 class EmuSettings;
+class PpuRenderThread;
+struct PpuScanlineJob;
 
 class Ppu : public ISerializable
 {
+	friend class PpuRenderThread;
+	friend class Mode7FetchTest; //Libretro/Mode7Compare
+	friend class ColorMathCompare; //Libretro/ColorMathCompare
+
 public:
 	constexpr static uint32_t SpriteRamSize = 544;
 	constexpr static uint32_t CgRamSize = 512;
@@ -20,6 +26,7 @@ public:
 private:
 	constexpr static int SpriteLayerIndex = 4;
 	constexpr static int ColorWindowIndex = 5;
+	constexpr static uint16_t Mode7NoPixel = 0x100;
 
 	Console* _console;
 	InternalRegisters* _regs;
@@ -34,6 +41,11 @@ private:
 	uint16_t _fetchBgStart = 0;
 	uint16_t _fetchBgEnd = 0;
 
+	//Decoded rows of 2/4/8bpp tiles (1 color index per pixel), indexed by bpp and by the VRAM address of the row's first word
+	//_tileCacheValid has 1 bit per bpp for each address, cleared whenever a word used by the row is written to
+	uint8_t *_tileCache = nullptr;
+	uint8_t _tileCacheValid[Ppu::VideoRamSize >> 1] = {};
+
 	//Temporary data used by the sprite evaluation/fetching
 	SpriteInfo _currentSprite = {};
 	uint8_t _oamEvaluationIndex = 0;
@@ -48,6 +60,11 @@ private:
 	uint8_t _spriteTileCount = 0;
 	bool _hasSpritePriority[4] = {};
 
+	//Sprites that are in range of each scanline (1 bit per OAM entry)
+	//Rebuilt before the first sprite evaluation that follows a change to OAM or to the sprite size/interlace settings
+	uint64_t _scanlineSprites[256][2] = {};
+	bool _scanlineSpritesDirty = true;
+
 	uint16_t _scanline = 0;
 	uint32_t _frameCount = 0;
 
@@ -81,6 +98,11 @@ private:
 	uint8_t _subScreenPriority[256] = {};
 	uint16_t _subScreenBuffer[256] = {};
 
+	//1 bit per pixel for each layer (and the color window), set when the pixel is inside the layer's window
+	//Recalculated before drawing, when the window registers have changed
+	uint64_t _windowMask[6][4] = {};
+	bool _windowMaskDirty = true;
+
 	uint32_t _mosaicColor[4] = {};
 	uint32_t _mosaicPriority[4] = {};
 	uint16_t _mosaicScanlineCounter = 0;
@@ -107,6 +129,19 @@ private:
 	bool _skipRender = false;
 	uint8_t _configVisibleLayers = 0xFF;
 
+	//Color math and brightness use 16 pixels at a time when the CPU supports AVX2
+	bool _useAvx2 = false;
+	//Only turned off to compare the SSE2 code with the scalar code (Libretro/ColorMathCompare)
+	bool _useSse2 = true;
+
+	//Hash of the data used to draw each scanline in each of the output buffers (0 = unknown content)
+	uint64_t _lineHashes[2][256] = {};
+	bool _lineCacheEnabled = true;
+	uint8_t _lineCacheSkipFrames = 0;
+	PpuLineCacheStats _lineCacheStats = {};
+	PpuLineCacheStats _frameLineCacheStats = {};
+	PpuLineCacheStats _prevFrameLineCacheStats = {};
+
 	uint8_t _spritePriority[256] = {};
 	uint8_t _spritePalette[256] = {};
 	uint8_t _spriteColors[256] = {};
@@ -114,6 +149,16 @@ private:
 	uint8_t _spritePaletteCopy[256] = {};
 	uint8_t _spriteColorsCopy[256] = {};
 
+	//Draws complete scanlines on a separate thread when enabled (scanlines with mid-scanline changes are drawn immediately)
+	unique_ptr<PpuRenderThread> _renderThread;
+
+	void DrawScanline();
+	uint64_t GetScanlineHash();
+	void InvalidateLineHashes(uint16_t *buffer);
+	void DrawScanline(const PpuScanlineJob &job);
+	void QueueScanline();
+	void WaitForRenderThread();
+
 	void RenderSprites(const uint8_t priorities[4]);
 
 	template<bool hiResMode>
@@ -122,6 +167,10 @@ private:
 	template<bool hiResMode, uint8_t bpp, bool secondTile = false>
 	void GetChrData(uint8_t layerIndex, uint8_t column, uint8_t plane);
 
+	template<uint8_t bpp>
+	void LoadTilePixels(TileData &tileData, bool secondTile, uint16_t addr);
+	void InvalidateTileCache(uint16_t addr);
+
 	void GetHorizontalOffsetByte(uint8_t columnIndex);
 	void GetVerticalOffsetByte(uint8_t columnIndex);
 	void FetchTileData();
@@ -157,6 +206,13 @@ private:
 	template<uint8_t bpp>
 	__forceinline uint8_t GetTilePixelColor(const uint16_t chrData[4], const uint8_t shift);
 
+	template<uint8_t bpp>
+	__forceinline uint8_t GetTilePixelColor(const TileData &tileData, const uint8_t tile, const uint8_t shift);
+
+	__forceinline uint16_t GetMode7Pixel(int32_t xOffset, int32_t yOffset);
+	void FetchMode7Pixels(int32_t xValue, int32_t yValue, int16_t xStep, int16_t yStep, uint16_t *pixels);
+	void FetchMode7PixelsScalar(int32_t xValue, int32_t yValue, int16_t xStep, int16_t yStep, uint16_t *pixels, int startX);
+
 	template<uint8_t layerIndex, uint8_t normalPriority, uint8_t highPriority>
 	__forceinline void RenderTilemapMode7();
 
@@ -170,16 +226,21 @@ private:
 	__forceinline void DrawSubPixel(uint8_t x, uint16_t color, uint8_t priority);
 
 	void ApplyColorMath();
-	void ApplyColorMathToPixel(uint16_t &pixelA, uint16_t pixelB, int x, bool isInsideWindow);
+	uint8_t GetColorMathFlags(bool isInsideWindow, bool allowColorMath, bool hasSubScreenPixel);
+	void ApplyColorMathToPixels(uint16_t *pixels, const uint16_t *otherPixels, const uint8_t *flags, int count);
+	__forceinline uint16_t ApplyColorMathToPixel(uint16_t pixelA, uint16_t pixelB, uint8_t flags);
 	
 	template<bool forMainScreen>
 	void ApplyBrightness();
 
 	void ConvertToHiRes();
 	void ApplyHiResMode();
+	void WriteHiResPixels(uint16_t *out, const uint16_t *evenPixels, const uint16_t *oddPixels);
 
 	template<uint8_t layerIndex>
-	bool ProcessMaskWindow(uint8_t activeWindowCount, int x);
+	__forceinline bool ProcessMaskWindow(bool windowEnabled, int x);
+
+	void UpdateWindowMasks();
 
 	void ProcessWindowMaskSettings(uint8_t value, uint8_t offset);
 
@@ -192,6 +253,7 @@ private:
 	bool IsDoubleWidth();
 
 	void EvaluateNextLineSprites();
+	void UpdateScanlineSprites();
 	void FetchSpriteData();
 	__forceinline void FetchSpritePosition(uint16_t oamAddress);
 	void FetchSpriteAttributes(uint16_t oamAddress);
@@ -199,9 +261,16 @@ private:
 
 	void UpdateOamAddress();
 	uint16_t GetOamAddress();
+
+	void WriteOamData(uint8_t value);
+	void WriteVramData(uint8_t value, bool highByte);
+	void WriteCgramData(uint8_t value);
 	
 	void RandomizeState();
 
+	//Render-only instance, used by PpuRenderThread
+	Ppu();
+
 public:
 	Ppu(Console* console);
 	virtual ~Ppu();
@@ -212,6 +281,7 @@ public:
 	void RenderScanline();
 
 	uint32_t GetFrameCount();
+	PpuLineCacheStats GetLineCacheStats();
 	uint16_t GetRealScanline();
 	uint16_t GetVblankEndScanline();
 	uint16_t GetScanline();
@@ -231,6 +301,8 @@ public:
 	uint16_t* GetScreenBuffer();
 	uint16_t* GetPreviousScreenBuffer();
 	uint8_t* GetVideoRam();
+	void InvalidateTileCache();
+	void InvalidateScanlineSprites();
 	uint8_t* GetCgRam();
 	uint8_t* GetSpriteRam();
 
@@ -241,5 +313,8 @@ public:
 	uint8_t Read(uint16_t addr);
 	void Write(uint32_t addr, uint8_t value);
 
+	bool CanWriteDmaBlock();
+	void WriteDmaBlock(uint8_t destAddress, const uint8_t *destOffsets, uint8_t offsetIndex, const uint8_t *data, uint16_t length);
+
 	void Serialize(Serializer &s) override;
 };
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "stdafx.h"
+#include "PpuRenderThread.h"
+#include "Ppu.h"
+
+PpuRenderThread::PpuRenderThread()
+{
+	//The render thread draws the scanlines with its own (render-only) PPU instance, using the state captured by the emulation thread
+	_ppu.reset(new Ppu());
+	_jobs.reset(new PpuScanlineJob[PpuRenderThread::QueueSize]);
+	_writePosition = 0;
+	_readPosition = 0;
+	_stopFlag = false;
+	_renderThread.reset(new std::thread(&PpuRenderThread::RenderThread, this));
+}
+
+PpuRenderThread::~PpuRenderThread()
+{
+	_stopFlag = true;
+	_waitForJob.Signal();
+	_renderThread->join();
+}
+
+void PpuRenderThread::RenderThread()
+{
+	while(!_stopFlag.load()) {
+		uint32_t readPos = _readPosition.load();
+		if(readPos == _writePosition.load()) {
+			_waitForJob.Wait();
+			continue;
+		}
+
+		_ppu->DrawScanline(_jobs[readPos % PpuRenderThread::QueueSize]);
+		_readPosition = readPos + 1;
+	}
+}
+
+PpuScanlineJob& PpuRenderThread::GetNextJob()
+{
+	uint32_t writePos = _writePosition.load();
+	if(writePos - _readPosition.load() >= PpuRenderThread::QueueSize) {
+		//Queue is full, wait for the render thread to catch up
+		_waitForJob.Signal();
+		while(writePos - _readPosition.load() >= PpuRenderThread::QueueSize) {
+			std::this_thread::yield();
+		}
+	}
+	return _jobs[writePos % PpuRenderThread::QueueSize];
+}
+
+void PpuRenderThread::QueueJob()
+{
+	uint32_t writePos = _writePosition.load() + 1;
+	_writePosition = writePos;
+
+	if(writePos - _signaledPosition >= PpuRenderThread::BatchSize) {
+		_signaledPosition = writePos;
+		_waitForJob.Signal();
+	}
+}
+
+void PpuRenderThread::WaitUntilIdle()
+{
+	uint32_t writePos = _writePosition.load();
+	if(_readPosition.load() != writePos) {
+		_signaledPosition = writePos;
+		_waitForJob.Signal();
+		while(_readPosition.load() != writePos) {
+			std::this_thread::yield();
+		}
+	}
+}
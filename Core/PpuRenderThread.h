@@ -0,0 +1,59 @@
+#pragma once
+#include "stdafx.h"
+#include <thread>
+#include "PpuTypes.h"
+#include "../Utilities/AutoResetEvent.h"
+
+class Ppu;
+
+//Copy of everything the PPU needs to draw a full scanline once its tile/sprite data has been fetched
+struct PpuScanlineJob
+{
+	PpuState State;
+	LayerData Layers[4];
+	uint16_t Cgram[256];
+	uint64_t WindowMask[6][4];
+
+	uint8_t SpritePriority[256];
+	uint8_t SpritePalette[256];
+	uint8_t SpriteColors[256];
+	bool HasSpritePriority[4];
+
+	uint16_t *OutputBuffer;
+	uint16_t Scanline;
+	uint16_t MosaicScanlineCounter;
+	uint8_t ConfigVisibleLayers;
+	uint8_t OddFrame;
+	bool OverscanFrame;
+	bool UseHighResOutput;
+};
+
+class PpuRenderThread
+{
+private:
+	//Large enough to hold every scanline of a frame, the queue is emptied before each frame is sent
+	static constexpr uint32_t QueueSize = 256;
+
+	//Number of queued scanlines before the render thread is woken up
+	static constexpr uint32_t BatchSize = 32;
+
+	unique_ptr<Ppu> _ppu;
+	unique_ptr<PpuScanlineJob[]> _jobs;
+	atomic<uint32_t> _writePosition;
+	atomic<uint32_t> _readPosition;
+	uint32_t _signaledPosition = 0;
+
+	unique_ptr<std::thread> _renderThread;
+	AutoResetEvent _waitForJob;
+	atomic<bool> _stopFlag;
+
+	void RenderThread();
+
+public:
+	PpuRenderThread();
+	~PpuRenderThread();
+
+	PpuScanlineJob& GetNextJob();
+	void QueueJob();
+	void WaitUntilIdle();
+};
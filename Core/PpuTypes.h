@@ -52,6 +52,10 @@ struct TileData
 	uint16_t TilemapData;
 	uint16_t VScroll;
 	uint16_t ChrData[4];
+
+	//Decoded color indexes for ChrData (for each of the 2 tiles used in hi-res modes), valid when PixelsBpp matches the layer's bpp
+	uint8_t Pixels[2][8];
+	uint8_t PixelsBpp[2];
 };
 
 struct LayerData
@@ -100,24 +104,6 @@ struct WindowConfig
 	bool InvertedLayers[6];
 	uint8_t Left;
 	uint8_t Right;
-
-	template<uint8_t layerIndex>
-	bool PixelNeedsMasking(int x)
-	{
-		if(InvertedLayers[layerIndex]) {
-			if(Left > Right) {
-				return true;
-			} else {
-				return x < Left || x > Right;
-			}
-		} else {
-			if(Left > Right) {
-				return false;
-			} else {
-				return x >= Left && x <= Right;
-			}
-		}
-	}
 };
 
 struct PpuState
@@ -184,7 +170,24 @@ struct PpuState
 };
 
 
+struct PpuLineCacheStats
+{
+	//Scanlines copied from the previous frame
+	uint64_t Hits;
+
+	//Scanlines that had to be drawn because their data differed from the previous frame's
+	uint64_t Misses;
+};
+
 enum PixelFlags
 {
 	AllowColorMath = 0x80,
+};
+
+enum ColorMathFlags
+{
+	ClipToBlack = 0x01,
+	ApplyColorMath = 0x02,
+	HalveResult = 0x04,
+	UseSubScreen = 0x08,
 };
\ No newline at end of file
@@ -59,4 +59,16 @@ public:
 		info.Type = _memoryType;
 		return info;
 	}
+
+	uint8_t* GetDirectReadPointer(uint32_t &mask) override
+	{
+		mask = _mask;
+		return _ram;
+	}
+
+	uint8_t* GetDirectWritePointer(uint32_t &mask) override
+	{
+		mask = _mask;
+		return _ram;
+	}
 };
\ No newline at end of file
@@ -33,6 +33,8 @@ uint8_t RegisterHandlerB::Read(uint32_t addr)
 		_wramPosition = (_wramPosition + 1) & 0x1FFFF;
 		return value;
 	} else if(addr >= 0x2300 && addr <= 0x23FF && _console->GetCartridge()->GetSa1()) {
+		//Catch up the SA-1 before the CPU reads its registers
+		_console->GetCartridge()->GetSa1()->Run();
 		return _console->GetCartridge()->GetSa1()->CpuRegisterRead(addr);
 	} else if(_msu1 && addr <= 0x2007) {
 		return _msu1->Read(addr);
@@ -71,6 +73,7 @@ void RegisterHandlerB::Write(uint32_t addr, uint8_t value)
 			case 0x2183: _wramPosition = (_wramPosition & 0xFFFF) | ((value & 0x01) << 16); break;
 		}
 	} else if(addr >= 0x2200 && addr <= 0x22FF && _console->GetCartridge()->GetSa1()) {
+		_console->GetCartridge()->GetSa1()->Run();
 		_console->GetCartridge()->GetSa1()->CpuRegisterWrite(addr, value);
 	} else if(_msu1 && addr <= 0x2007) {
 		return _msu1->Write(addr, value);
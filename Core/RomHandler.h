@@ -10,4 +10,9 @@ public:
 	void Write(uint32_t addr, uint8_t value) override
 	{
 	}
+
+	uint8_t* GetDirectWritePointer(uint32_t &mask) override
+	{
+		return nullptr;
+	}
 };
\ No newline at end of file
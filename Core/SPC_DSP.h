@@ -46,6 +46,15 @@ public:
 	void run();
 	
 	bool isMuted() { return (m.regs[r_flg] & 0x40) != 0; }
+
+	// Returns false if echo writes to RAM are disabled, otherwise returns the start address of the echo buffer,
+	// both the one in use and the one set in ESA (which gets latched on the next sample)
+	bool getEchoWriteRange(uint16_t &start, uint16_t &nextStart)
+	{
+		start = (uint16_t)(m.t_esa * 0x100);
+		nextStart = (uint16_t)(m.regs[r_esa] * 0x100);
+		return !(m.t_echo_enabled & 0x20) || !(m.regs[r_flg] & 0x20);
+	}
 	void copyRegs(uint8_t* output) { memcpy(output, m.regs, register_count); }
 	uint8_t readRam(uint16_t addr);
 	void writeRam(uint16_t addr, uint8_t value);
@@ -12,6 +12,7 @@
 #include "Sa1IRamHandler.h"
 #include "Sa1BwRamHandler.h"
 #include "CpuBwRamHandler.h"
+#include "CoprocessorSyncHandler.h"
 #include "MessageManager.h"
 #include "BatteryManager.h"
 #include "../Utilities/HexUtilities.h"
@@ -28,6 +29,7 @@ Sa1::Sa1(Console* console) : BaseCoprocessor(SnesMemoryType::Register)
 	
 	_iRam = new uint8_t[Sa1::InternalRamSize];
 	_iRamHandler.reset(new Sa1IRamHandler(_iRam));
+	_cpuIRamHandler.reset(new CoprocessorSyncHandler(_iRamHandler.get(), this));
 	console->GetSettings()->InitializeRam(_iRam, 0x800);
 	
 	//Register the SA1 in the CPU's memory space ($22xx-$23xx registers)
@@ -35,8 +37,8 @@ Sa1::Sa1(Console* console) : BaseCoprocessor(SnesMemoryType::Register)
 	_mappings.RegisterHandler(0x00, 0x3F, 0x2000, 0x2FFF, this);
 	_mappings.RegisterHandler(0x80, 0xBF, 0x2000, 0x2FFF, this);
 	
-	cpuMappings->RegisterHandler(0x00, 0x3F, 0x3000, 0x3FFF, _iRamHandler.get());
-	cpuMappings->RegisterHandler(0x80, 0xBF, 0x3000, 0x3FFF, _iRamHandler.get());
+	cpuMappings->RegisterHandler(0x00, 0x3F, 0x3000, 0x3FFF, _cpuIRamHandler.get());
+	cpuMappings->RegisterHandler(0x80, 0xBF, 0x3000, 0x3FFF, _cpuIRamHandler.get());
 
 	_mappings.RegisterHandler(0x00, 0x3F, 0x3000, 0x3FFF, _iRamHandler.get());
 	_mappings.RegisterHandler(0x80, 0xBF, 0x3000, 0x3FFF, _iRamHandler.get());
@@ -59,6 +61,7 @@ Sa1::Sa1(Console* console) : BaseCoprocessor(SnesMemoryType::Register)
 	vector<unique_ptr<IMemoryHandler>> &saveRamHandlers = _cart->GetSaveRamHandlers();
 	for(unique_ptr<IMemoryHandler> &handler : saveRamHandlers) {
 		_cpuBwRamHandlers.push_back(unique_ptr<IMemoryHandler>(new CpuBwRamHandler(handler.get(), &_state, this)));
+		_cpuSaveRamHandlers.push_back(unique_ptr<IMemoryHandler>(new CoprocessorSyncHandler(handler.get(), this)));
 	}
 	cpuMappings->RegisterHandler(0x40, 0x4F, 0x0000, 0xFFFF, _cpuBwRamHandlers);
 	_mappings.RegisterHandler(0x40, 0x4F, 0x0000, 0xFFFF, saveRamHandlers);
@@ -442,7 +445,9 @@ void Sa1::WriteSa1(uint32_t addr, uint8_t value, MemoryOperationType type)
 	if(handler) {
 		_lastAccessMemType = handler->GetMemoryType();
 		_openBus = value;
-		handler->Write(addr, value);
+		if(!_mappings.TryWrite(addr, value)) {
+			handler->Write(addr, value);
+		}
 	} else {
 		LogDebug("[Debug] Write SA1 - missing handler: $" + HexUtilities::ToHex(addr));
 	}
@@ -453,7 +458,9 @@ uint8_t Sa1::ReadSa1(uint32_t addr, MemoryOperationType type)
 	IMemoryHandler *handler = _mappings.GetHandler(addr);
 	uint8_t value;
 	if(handler) {
-		value = handler->Read(addr);
+		if(!_mappings.TryRead(addr, value)) {
+			value = handler->Read(addr);
+		}
 		_lastAccessMemType = handler->GetMemoryType();
 		_openBus = value;
 	} else {
@@ -612,7 +619,8 @@ void Sa1::UpdateVectorMappings()
 
 void Sa1::UpdateSaveRamMappings()
 {
-	vector<unique_ptr<IMemoryHandler>> &saveRamHandlers = _cart->GetSaveRamHandlers();
+	//The S-CPU accesses BW-RAM through handlers that catch up the SA-1 first
+	vector<unique_ptr<IMemoryHandler>> &saveRamHandlers = _cpuSaveRamHandlers;
 	if(saveRamHandlers.size() > 0) {
 		MemoryMappings* cpuMappings = _memoryManager->GetMemoryMappings();
 		uint32_t bank1 = (_state.CpuBwBank * 2) % saveRamHandlers.size();
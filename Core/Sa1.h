@@ -15,6 +15,8 @@ class BaseCartridge;
 
 class Sa1 : public BaseCoprocessor
 {
+	friend class CpuBench; //Libretro/CpuBench
+
 private:
 	static constexpr int InternalRamSize = 0x800;
 
@@ -31,10 +33,12 @@ private:
 	uint8_t _openBus;
 
 	unique_ptr<IMemoryHandler> _iRamHandler;
+	unique_ptr<IMemoryHandler> _cpuIRamHandler;
 	unique_ptr<IMemoryHandler> _bwRamHandler;
 	unique_ptr<IMemoryHandler> _cpuVectorHandler;
 	
 	vector<unique_ptr<IMemoryHandler>> _cpuBwRamHandlers;
+	vector<unique_ptr<IMemoryHandler>> _cpuSaveRamHandlers;
 
 	MemoryMappings _mappings;
 	
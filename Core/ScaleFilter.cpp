@@ -4,18 +4,14 @@
 #include "../Utilities/HQX/hqx.h"
 #include "../Utilities/Scale2x/scalebit.h"
 #include "../Utilities/KreedSaiEagle/SaiEagle.h"
+#include "../Utilities/ThreadPool.h"
 
-bool ScaleFilter::_hqxInitDone = false;
+std::once_flag ScaleFilter::_hqxInitFlag;
 
 ScaleFilter::ScaleFilter(ScaleFilterType scaleFilterType, uint32_t scale)
 {
 	_scaleFilterType = scaleFilterType;
 	_filterScale = scale;
-
-	if(!_hqxInitDone && _scaleFilterType == ScaleFilterType::HQX) {
-		hqxInit();
-		_hqxInitDone = true;
-	}
 }
 
 ScaleFilter::~ScaleFilter()
@@ -28,11 +24,12 @@ uint32_t ScaleFilter::GetScale()
 	return _filterScale;
 }
 
-void ScaleFilter::ApplyPrescaleFilter(uint32_t *inputArgbBuffer)
+void ScaleFilter::ApplyPrescaleFilter(uint32_t *inputArgbBuffer, uint32_t yFirst, uint32_t yLast)
 {
-	uint32_t* outputBuffer = _outputBuffer;
+	uint32_t* outputBuffer = _outputBuffer + yFirst * _width * _filterScale * _filterScale;
+	inputArgbBuffer += yFirst * _width;
 
-	for(uint32_t y = 0; y < _height; y++) {
+	for(uint32_t y = yFirst; y < yLast; y++) {
 		for(uint32_t x = 0; x < _width; x++) {
 			for(uint32_t i = 0; i < _filterScale; i++) {
 				*(outputBuffer++) = *inputArgbBuffer;
@@ -56,40 +53,47 @@ void ScaleFilter::UpdateOutputBuffer(uint32_t width, uint32_t height)
 	}
 }
 
-uint32_t* ScaleFilter::ApplyFilter(uint32_t *inputArgbBuffer, uint32_t width, uint32_t height, double scanlineIntensity)
+void ScaleFilter::ScaleRows(uint32_t *inputArgbBuffer, uint32_t width, uint32_t height, uint32_t yFirst, uint32_t yLast, uint8_t scanlineIntensity)
 {
-	UpdateOutputBuffer(width, height);
-
 	if(_scaleFilterType == ScaleFilterType::xBRZ) {
-		xbrz::scale(_filterScale, inputArgbBuffer, _outputBuffer, width, height, xbrz::ColorFormat::ARGB);
+		xbrz::scale(_filterScale, inputArgbBuffer, _outputBuffer, width, height, xbrz::ColorFormat::ARGB, xbrz::ScalerCfg(), yFirst, yLast);
 	} else if(_scaleFilterType == ScaleFilterType::HQX) {
-		hqx(_filterScale, inputArgbBuffer, _outputBuffer, width, height);
+		hqx(_filterScale, inputArgbBuffer, _outputBuffer, width, height, yFirst, yLast);
 	} else if(_scaleFilterType == ScaleFilterType::Scale2x) {
-		scale(_filterScale, _outputBuffer, width*sizeof(uint32_t)*_filterScale, inputArgbBuffer, width*sizeof(uint32_t), 4, width, height);
+		scale_slice(_filterScale, _outputBuffer, width*sizeof(uint32_t)*_filterScale, inputArgbBuffer, width*sizeof(uint32_t), 4, width, height, yFirst, yLast);
 	} else if(_scaleFilterType == ScaleFilterType::_2xSai) {
-		twoxsai_generic_xrgb8888(width, height, inputArgbBuffer, width, _outputBuffer, width * _filterScale);
+		twoxsai_generic_xrgb8888(width, height, inputArgbBuffer, width, _outputBuffer, width * _filterScale, yFirst, yLast);
 	} else if(_scaleFilterType == ScaleFilterType::Super2xSai) {
-		supertwoxsai_generic_xrgb8888(width, height, inputArgbBuffer, width, _outputBuffer, width * _filterScale);
+		supertwoxsai_generic_xrgb8888(width, height, inputArgbBuffer, width, _outputBuffer, width * _filterScale, yFirst, yLast);
 	} else if(_scaleFilterType == ScaleFilterType::SuperEagle) {
-		supereagle_generic_xrgb8888(width, height, inputArgbBuffer, width, _outputBuffer, width * _filterScale);
+		supereagle_generic_xrgb8888(width, height, inputArgbBuffer, width, _outputBuffer, width * _filterScale, yFirst, yLast);
 	} else if(_scaleFilterType == ScaleFilterType::Prescale) {
-		ApplyPrescaleFilter(inputArgbBuffer);
+		ApplyPrescaleFilter(inputArgbBuffer, yFirst, yLast);
 	}
 
-	scanlineIntensity = 1.0 - scanlineIntensity;
-
-	if(scanlineIntensity < 1.0) {
-		for(int y = 1, yMax = height * _filterScale; y < yMax; y += 2) {
-			for(int x = 0, xMax = width * _filterScale; x < xMax; x++) {
-				uint32_t &color = _outputBuffer[y*xMax + x];
-				uint8_t r = (color >> 16) & 0xFF, g = (color >> 8) & 0xFF, b = color & 0xFF;
-				r = (uint8_t)(r * scanlineIntensity);
-				g = (uint8_t)(g * scanlineIntensity);
-				b = (uint8_t)(b * scanlineIntensity);
-				color = 0xFF000000 | (r << 16) | (g << 8) | b;
+	if(scanlineIntensity < 255) {
+		uint32_t outputWidth = width * _filterScale;
+		for(uint32_t y = yFirst * _filterScale, yMax = yLast * _filterScale; y < yMax; y++) {
+			if(y & 0x01) {
+				BaseVideoFilter::ApplyScanlineEffect(_outputBuffer + y * outputWidth, outputWidth, scanlineIntensity);
 			}
 		}
 	}
+}
+
+uint32_t* ScaleFilter::ApplyFilter(uint32_t *inputArgbBuffer, uint32_t width, uint32_t height, double scanlineIntensity)
+{
+	UpdateOutputBuffer(width, height);
+
+	uint8_t intensity = (uint8_t)((1.0 - scanlineIntensity) * 255);
+
+	//The image is split into horizontal bands that are scaled in parallel
+	//The filters read the source rows around each band, so the result is identical to scaling the whole image at once
+	ThreadPool* pool = ThreadPool::GetSharedPool();
+	uint32_t bandCount = std::max<uint32_t>(1, std::min<uint32_t>(pool->GetThreadCount(), height / ScaleFilter::MinBandHeight));
+	pool->Run(bandCount, [=](uint32_t band) {
+		ScaleRows(inputArgbBuffer, width, height, height * band / bandCount, height * (band + 1) / bandCount, intensity);
+	});
 
 	return _outputBuffer;
 }
@@ -124,6 +128,11 @@ shared_ptr<ScaleFilter> ScaleFilter::GetScaleFilter(VideoFilterType filter)
 		case VideoFilterType::Prescale8x: scaleFilter.reset(new ScaleFilter(ScaleFilterType::Prescale, 8)); break;
 		case VideoFilterType::Prescale10x: scaleFilter.reset(new ScaleFilter(ScaleFilterType::Prescale, 10)); break;
 	}
+
+	if(scaleFilter && scaleFilter->_scaleFilterType == ScaleFilterType::HQX) {
+		//Only build HQX's lookup tables once it's actually used
+		std::call_once(_hqxInitFlag, hqxInit);
+	}
 	return scaleFilter;
 }
 
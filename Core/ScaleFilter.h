@@ -1,19 +1,24 @@
 #pragma once
 
 #include "stdafx.h"
+#include <mutex>
 #include "DefaultVideoFilter.h"
 
 class ScaleFilter
 {
 private:
-	static bool _hqxInitDone;
+	//Fewer rows per band would make the filters' extra reads around each band (and the thread synchronization) too costly
+	static constexpr uint32_t MinBandHeight = 16;
+
+	static std::once_flag _hqxInitFlag;
 	uint32_t _filterScale;
 	ScaleFilterType _scaleFilterType;
 	uint32_t *_outputBuffer = nullptr;
 	uint32_t _width = 0;
 	uint32_t _height = 0;
 
-	void ApplyPrescaleFilter(uint32_t *inputArgbBuffer);
+	void ApplyPrescaleFilter(uint32_t *inputArgbBuffer, uint32_t yFirst, uint32_t yLast);
+	void ScaleRows(uint32_t *inputArgbBuffer, uint32_t width, uint32_t height, uint32_t yFirst, uint32_t yLast, uint8_t scanlineIntensity);
 	void UpdateOutputBuffer(uint32_t width, uint32_t height);
 
 public:
@@ -10,6 +10,9 @@ enum class EmulationFlags
 	MaximumSpeed = 0x04,
 	InBackground = 0x08,
 	GameboyMode = 0x10,
+
+	//Frames are not drawn or sent to the video decoder (CPU-visible PPU behavior is unchanged)
+	Headless = 0x20,
 };
 
 enum class ScaleFilterType
@@ -84,6 +87,16 @@ struct VideoConfig
 	bool HideSprites = false;
 	bool DisableFrameSkipping = false;
 
+	//Draw the scanlines on a separate thread, while the emulation thread runs ahead
+	bool EnableRenderThread = false;
+
+	//Copy scanlines from the previous frame when everything used to draw them is unchanged
+	bool EnableLineCache = true;
+
+	//Libretro: filter each frame on the decode thread while the next frame is emulated
+	//The frame is sent to the frontend at the end of the next frame, so the video output is 1 frame late
+	bool EnablePipelinedDecode = false;
+
 	double Brightness = 0;
 	double Contrast = 0;
 	double Hue = 0;
@@ -290,6 +303,15 @@ struct EmulationConfig
 	int64_t BsxCustomDate = -1;
 
 	bool EnableHleCoprocessor = false;
+
+	//Max number of master clocks the SA-1/GSU/CX4 can lag behind the main CPU (0 = sync after every CPU cycle)
+	uint32_t CoprocessorSyncQuantum = 64;
+
+	//Skip over iterations of loops where the CPU is only waiting for an interrupt/event (does not affect accuracy)
+	bool EnableIdleLoopSkipping = true;
+
+	//Periodically write the counters of the idle loop skipping/line cache optimizations to the log
+	bool LogPerformanceCounters = false;
 };
 
 struct GameboyConfig
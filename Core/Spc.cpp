@@ -62,6 +62,7 @@ void Spc::Reset()
 {
 	_state.StopState = CpuStopState::Running;
 
+	RunTimers();
 	_state.Timer0.Reset();
 	_state.Timer1.Reset();
 	_state.Timer2.Reset();
@@ -85,6 +86,7 @@ void Spc::Reset()
 	_operandA = 0;
 	_operandB = 0;
 
+	RunDsp();
 	_dsp->soft_reset();
 	_dsp->set_output(_soundBuffer, Spc::SampleBufferSize >> 1);
 }
@@ -132,11 +134,11 @@ void Spc::DummyRead(uint16_t addr)
 	Read(addr, MemoryOperationType::DummyRead);
 }
 
+static constexpr uint8_t cpuWait[4] = { 2, 4, 10, 20 };
+static constexpr uint8_t timerMultiplier[4] = { 2, 4, 8, 16 };
+
 void Spc::IncCycleCount(int32_t addr)
 {
-	static constexpr uint8_t cpuWait[4] = { 2, 4, 10, 20 };
-	static constexpr uint8_t timerMultiplier[4] = { 2, 4, 8, 16 };
-
 	uint8_t speedSelect;
 	if(addr < 0 || ((addr & 0xFFF0) == 0x00F0) || (addr >= 0xFFC0 && _state.RomEnabled)) {
 		//Use internal speed (bits 4-5) for idle cycles, register access or IPL rom access
@@ -146,16 +148,58 @@ void Spc::IncCycleCount(int32_t addr)
 	}
 
 	_state.Cycle += cpuWait[speedSelect];
+
+	//The DSP and timers are only caught up when their state can be observed (see RunDsp/RunTimers)
 #ifndef DUMMYSPC
-	_dsp->run();
+	_pendingDspClocks++;
 #endif
+	_pendingTimerClocks += timerMultiplier[speedSelect];
+
+#if defined(SPC_PER_CYCLE_DSP) && !defined(DUMMYSPC)
+	//Reference build used by Libretro/AudioCompare: clock the DSP and timers on every cycle instead
+	RunTimers();
+	RunDsp();
+#endif
+}
 
-	uint8_t timerInc = timerMultiplier[speedSelect];
-	_state.Timer0.Run(timerInc);
-	_state.Timer1.Run(timerInc);
-	_state.Timer2.Run(timerInc);
+void Spc::RunTimers()
+{
+	if(_pendingTimerClocks) {
+		_state.Timer0.Run(_pendingTimerClocks);
+		_state.Timer1.Run(_pendingTimerClocks);
+		_state.Timer2.Run(_pendingTimerClocks);
+		_pendingTimerClocks = 0;
+	}
 }
 
+void Spc::RunDsp()
+{
+#ifndef DUMMYSPC
+	for(uint32_t i = 0; i < _pendingDspClocks; i++) {
+		_dsp->run();
+	}
+	_pendingDspClocks = 0;
+	UpdateEchoWriteRange();
+#endif
+}
+
+#ifndef DUMMYSPC
+void Spc::UpdateEchoWriteRange()
+{
+	//Until the DSP runs again, its echo writes can only reach the buffer that is being used or the one set in ESA
+	//(the size of each is at most $7800 bytes). These can only change when the DSP runs or when its registers are written to.
+	_echoWriteEnabled = _dsp->getEchoWriteRange(_echoStart[0], _echoStart[1]);
+}
+
+bool Spc::IsEchoWriteRange(uint16_t addr, uint16_t length)
+{
+	return _echoWriteEnabled && (
+		(uint16_t)(addr + length - 1 - _echoStart[0]) < 0x7800 + length - 1 ||
+		(uint16_t)(addr + length - 1 - _echoStart[1]) < 0x7800 + length - 1
+	);
+}
+#endif
+
 uint8_t Spc::DebugRead(uint16_t addr)
 {
 	if(addr >= 0xFFC0 && _state.RomEnabled) {
@@ -209,6 +253,7 @@ uint8_t Spc::Read(uint16_t addr, MemoryOperationType type)
 			case 0xF2: value = _state.DspReg; break;
 			case 0xF3: 
 				#ifndef DUMMYSPC
+				RunDsp();
 				value = _dsp->read(_state.DspReg & 0x7F);
 				#else
 				value = 0;
@@ -227,15 +272,26 @@ uint8_t Spc::Read(uint16_t addr, MemoryOperationType type)
 			case 0xFB: value = 0; break;
 			case 0xFC: value = 0; break;
 
-			case 0xFD: value = _state.Timer0.GetOutput(); break;
-			case 0xFE: value = _state.Timer1.GetOutput(); break;
-			case 0xFF: value = _state.Timer2.GetOutput(); break;
+			case 0xFD: RunTimers(); value = _state.Timer0.GetOutput(); break;
+			case 0xFE: RunTimers(); value = _state.Timer1.GetOutput(); break;
+			case 0xFF: RunTimers(); value = _state.Timer2.GetOutput(); break;
 
-			default: value = _ram[addr]; break;
+			default:
+				#ifndef DUMMYSPC
+				if(_pendingDspClocks && IsEchoWriteRange(addr, 1)) {
+					//The DSP may have written to this address in the echo buffer
+					RunDsp();
+				}
+				#endif
+				value = _ram[addr];
+				break;
 		}
 	}
 
 #ifndef DUMMYSPC
+	if(_idleLoopStable) {
+		ProcessIdleLoopRead(addr, value);
+	}
 	_console->ProcessMemoryRead<CpuType::Spc>(addr, value, type);
 #else 
 	LogRead(addr, value);
@@ -251,6 +307,14 @@ void Spc::Write(uint16_t addr, uint8_t value, MemoryOperationType type)
 #ifdef DUMMYSPC
 	LogWrite(addr, value);
 #else
+	_idleLoopStable = false;
+
+	//The DSP may read the RAM that's about to be written, and its registers need to be up to date before writing to them
+	RunDsp();
+	if(addr == 0xF0 || addr == 0xF1 || (addr >= 0xFA && addr <= 0xFC)) {
+		//Timer configuration
+		RunTimers();
+	}
 
 	//Writes always affect the underlying RAM
 	if(_state.WriteEnabled) {
@@ -293,6 +357,7 @@ void Spc::Write(uint16_t addr, uint8_t value, MemoryOperationType type)
 		case 0xF3: 
 			if(_state.DspReg < 128) {
 				_dsp->write(_state.DspReg, value);
+				UpdateEchoWriteRange();
 			}
 			break;
 
@@ -324,6 +389,10 @@ void Spc::CpuWriteRegister(uint32_t addr, uint8_t value)
 {
 	Run();
 	_state.CpuRegs[addr & 0x03] = value;
+#ifndef DUMMYSPC
+	//The port values only change between calls to Run(), an iteration that started before this can't be trusted
+	_idleLoopStable = false;
+#endif
 }
 
 uint8_t Spc::DspReadRam(uint16_t addr)
@@ -351,6 +420,9 @@ void Spc::Run()
 	}
 
 	uint64_t targetCycle = (uint64_t)(_memoryManager->GetMasterClock() * _clockRatio);
+#ifndef DUMMYSPC
+	_targetCycle = targetCycle;
+#endif
 	while(_state.Cycle < targetCycle) {
 		ProcessCycle();
 	}
@@ -359,6 +431,17 @@ void Spc::Run()
 void Spc::ProcessCycle()
 {
 	if(_opStep == SpcOpStep::ReadOpCode) {
+#ifndef DUMMYSPC
+		if(_idleLoopSkipEnabled && (uint16_t)(_opPc - _state.PC) <= Spc::MaxIdleLoopSize) {
+			//Jumped back to the start of a short loop (or to the same instruction)
+			ProcessIdleLoop();
+			if(_state.Cycle >= _targetCycle) {
+				//Caught up, the opcode will be read on the next call to Run()
+				return;
+			}
+		}
+		_opPc = _state.PC;
+#endif
 		_opCode = GetOpCode();
 		_opStep = SpcOpStep::Addressing;
 		_opSubStep = 0;
@@ -367,9 +450,125 @@ void Spc::ProcessCycle()
 	}
 }
 
+#ifndef DUMMYSPC
+void Spc::ProcessIdleLoop()
+{
+	//If the previous iteration of this loop did not write anything, only read its own code, the CPU ports and timers
+	//that were still at 0, and ended in the same state it started in, the following iterations will do the exact same
+	//thing until the CPU writes to a port (between calls to Run) or one of the polled timers ticks. These iterations are
+	//skipped, but the DSP and timers still run for each of their cycles, so the audio output is unchanged.
+	if(_idleLoopStable && _state.PC == _idleLoopAddr && _state.Cycle > _idleLoopCycle && IsIdleLoopSkippable()) {
+		uint32_t loopCycles = (uint32_t)(_state.Cycle - _idleLoopCycle);
+		uint32_t loopAccessCount = loopCycles / cpuWait[_state.InternalSpeed];
+		uint32_t loopTimerClocks = loopAccessCount * timerMultiplier[_state.InternalSpeed];
+
+		RunTimers();
+		while(_state.Cycle + loopCycles <= _targetCycle && RunIdleLoopTimers(loopTimerClocks)) {
+			_state.Cycle += loopCycles;
+			_pendingDspClocks += loopAccessCount;
+			_idleCyclesSkipped += loopCycles;
+		}
+	}
+
+	_idleLoopStable = true;
+	_idleLoopTimerReads = 0;
+	_idleLoopAddr = _state.PC;
+	_idleLoopCycle = _state.Cycle;
+	_idleLoopState = _state;
+}
+
+bool Spc::IsIdleLoopSkippable()
+{
+	//Every access must take the same time, to be able to run the skipped cycles without knowing the addresses
+	if(_state.InternalSpeed != _state.ExternalSpeed) {
+		return false;
+	}
+
+	SpcState &prev = _idleLoopState;
+	if(_state.A != prev.A || _state.X != prev.X || _state.Y != prev.Y || _state.SP != prev.SP || _state.PS != prev.PS) {
+		return false;
+	}
+
+	if((_idleLoopAddr < 0xFFC0 || !_state.RomEnabled) && IsEchoWriteRange(_idleLoopAddr, Spc::MaxIdleLoopSize + 3)) {
+		//The DSP's echo writes could overwrite the loop
+		return false;
+	}
+
+	return true;
+}
+
+bool Spc::RunIdleLoopTimers(uint32_t clocks)
+{
+	//Runs the timers for one iteration of the loop, unless a timer read by the loop would end up with a non-zero value
+	SpcTimer<128> timer0 = _state.Timer0;
+	SpcTimer<128> timer1 = _state.Timer1;
+	SpcTimer<16> timer2 = _state.Timer2;
+	timer0.Run(clocks);
+	timer1.Run(clocks);
+	timer2.Run(clocks);
+
+	if(
+		((_idleLoopTimerReads & 0x01) && timer0.DebugRead()) ||
+		((_idleLoopTimerReads & 0x02) && timer1.DebugRead()) ||
+		((_idleLoopTimerReads & 0x04) && timer2.DebugRead())
+	) {
+		return false;
+	}
+
+	_state.Timer0 = timer0;
+	_state.Timer1 = timer1;
+	_state.Timer2 = timer2;
+	return true;
+}
+
+void Spc::ProcessIdleLoopRead(uint16_t addr, uint8_t value)
+{
+	if(addr >= 0xFFC0 && _state.RomEnabled) {
+		//IPL ROM
+		return;
+	}
+
+	switch(addr) {
+		case 0xF3:
+			//DSP registers change on their own
+			_idleLoopStable = false;
+			break;
+
+		case 0xFD: case 0xFE: case 0xFF:
+			if(value) {
+				_idleLoopStable = false;
+			} else {
+				_idleLoopTimerReads |= 1 << (addr - 0xFD);
+			}
+			break;
+
+		default:
+			if((addr & 0xFFF0) != 0x00F0 && (uint16_t)(addr - _idleLoopAddr) >= Spc::MaxIdleLoopSize + 3) {
+				//Only the loop's own code can be read, the DSP may write to other parts of RAM
+				_idleLoopStable = false;
+			}
+			break;
+	}
+}
+
+uint64_t Spc::GetSkippedIdleCycles()
+{
+	//Number of SPC cycles that were skipped by idle loop detection during the last frame
+	return _prevFrameIdleCyclesSkipped;
+}
+#endif
+
 void Spc::ProcessEndFrame()
 {
 	Run();
+	RunTimers();
+	RunDsp();
+
+#ifndef DUMMYSPC
+	_idleLoopSkipEnabled = _console->GetSettings()->GetEmulationConfig().EnableIdleLoopSkipping && !_console->IsDebugging();
+	_prevFrameIdleCyclesSkipped = _idleCyclesSkipped;
+	_idleCyclesSkipped = 0;
+#endif
 
 	UpdateClockRatio();
 
@@ -382,11 +581,13 @@ void Spc::ProcessEndFrame()
 
 SpcState Spc::GetState()
 {
+	RunTimers();
 	return _state;
 }
 
 DspState Spc::GetDspState()
 {
+	RunDsp();
 	DspState state;
 	_dsp->copyRegs(state.Regs);
 	return state;
@@ -431,6 +632,16 @@ uint8_t* Spc::GetSpcRom()
 
 void Spc::Serialize(Serializer &s)
 {
+	if(s.IsSaving()) {
+		RunTimers();
+		RunDsp();
+	} else {
+		_pendingTimerClocks = 0;
+#ifndef DUMMYSPC
+		_pendingDspClocks = 0;
+#endif
+	}
+
 	s.Stream(_state.A, _state.Cycle, _state.PC, _state.PS, _state.SP, _state.X, _state.Y);
 	s.Stream(_state.CpuRegs[0], _state.CpuRegs[1], _state.CpuRegs[2], _state.CpuRegs[3]);
 	s.Stream(_state.OutputReg[0], _state.OutputReg[1], _state.OutputReg[2], _state.OutputReg[3]);
@@ -442,6 +653,10 @@ void Spc::Serialize(Serializer &s)
 	_state.Timer1.Serialize(s);
 	_state.Timer2.Serialize(s);
 
+#ifndef DUMMYSPC
+	_idleLoopStable = false;
+#endif
+
 	ArrayInfo<uint8_t> ram { _ram, Spc::SpcRamSize };
 	s.Stream(ram);
 
@@ -467,6 +682,9 @@ void Spc::Serialize(Serializer &s)
 		});
 
 		_dsp->set_output(_soundBuffer, Spc::SampleBufferSize >> 1);
+#ifndef DUMMYSPC
+		UpdateEchoWriteRange();
+#endif
 	}
 
 	s.Stream(_operandA, _operandB, _tmp1, _tmp2, _tmp3, _opCode, _opStep, _opSubStep, _enabled, _state.TimersDisabled);
@@ -46,6 +46,7 @@ private:
 	bool _enabled;
 
 	SpcState _state;
+	uint32_t _pendingTimerClocks = 0;
 	uint8_t* _ram;
 	uint8_t _spcBios[64] {
 		0xCD, 0xEF, 0xBD, 0xE8, 0x00, 0xC6, 0x1D, 0xD0,
@@ -275,6 +276,8 @@ private:
 	uint8_t ReadOperandByte();
 
 	void IncCycleCount(int32_t addr);
+	void RunTimers();
+	void RunDsp();
 	void EndOp();
 	void EndAddr();
 	void ProcessCycle();
@@ -282,6 +285,35 @@ private:
 	
 	void UpdateClockRatio();
 
+#ifndef DUMMYSPC
+	//Idle loop skipping
+	static constexpr uint16_t MaxIdleLoopSize = 16;
+
+	bool _idleLoopSkipEnabled = false;
+	bool _idleLoopStable = false;
+	uint8_t _idleLoopTimerReads = 0;
+	uint16_t _idleLoopAddr = 0;
+	uint16_t _opPc = 0;
+	uint64_t _idleLoopCycle = 0;
+	uint64_t _targetCycle = 0;
+	SpcState _idleLoopState = {};
+	uint64_t _idleCyclesSkipped = 0;
+	uint64_t _prevFrameIdleCyclesSkipped = 0;
+
+	void ProcessIdleLoop();
+	bool IsIdleLoopSkippable();
+	bool RunIdleLoopTimers(uint32_t clocks);
+	void ProcessIdleLoopRead(uint16_t addr, uint8_t value);
+
+	//Batched DSP clocking
+	uint32_t _pendingDspClocks = 0;
+	bool _echoWriteEnabled = false;
+	uint16_t _echoStart[2] = {};
+
+	void UpdateEchoWriteRange();
+	bool IsEchoWriteRange(uint16_t addr, uint16_t length);
+#endif
+
 public:
 	Spc(Console* console);
 	virtual ~Spc();
@@ -301,6 +333,9 @@ public:
 	void DspWriteRam(uint16_t addr, uint8_t value);
 
 	void ProcessEndFrame();
+#ifndef DUMMYSPC
+	uint64_t GetSkippedIdleCycles();
+#endif
 
 	SpcState GetState();
 	DspState GetDspState();
@@ -57,15 +57,17 @@ public:
 		ClockTimer();
 	}
 
-	void Run(uint8_t step)
+	void Run(uint32_t step)
 	{
-		_stage0 += step;
-		if(_stage0 >= rate) {
+		//Steps can be accumulated over several SPC cycles, the result is the same as running them one by one
+		step += _stage0;
+		while(step >= rate) {
 			_stage1 ^= 0x01;
-			_stage0 -= rate;
+			step -= rate;
 
 			ClockTimer();
 		}
+		_stage0 = (uint8_t)step;
 	}
 
 	void SetTarget(uint8_t target)
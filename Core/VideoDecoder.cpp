@@ -81,17 +81,26 @@ void VideoDecoder::UpdateVideoFilter()
 	}
 }
 
-void VideoDecoder::DecodeFrame(bool forRewind)
+void VideoDecoder::FilterFrame(bool forRewind)
 {
 	UpdateVideoFilter();
 
 	_videoFilter->SetBaseFrameInfo(_baseFrameInfo);
-	_videoFilter->SendFrame(_ppuOutputBuffer, _frameNumber);
-
-	uint32_t* outputBuffer = _videoFilter->GetOutputBuffer();
 	FrameInfo frameInfo = _videoFilter->GetFrameInfo();
-	
 	_inputHud->DrawControllers(_videoFilter->GetOverscan(), _frameNumber);
+
+	//When the frame is sent to the renderer as is, let the filter write it directly into the renderer's buffer (if it has one)
+	//The HUD draws with the frame's width as the pitch, so it needs the filter's own buffer
+	//A deferred frame is sent later on, and the renderer's buffer is only valid until then
+	uint32_t* frameBuffer = nullptr;
+	uint32_t pitch = 0;
+	if(!_scaleFilter && !forRewind && !_deferFrameOutput && !_console->GetDebugHud()->HasCommands() && !_console->GetRewindManager()->IsRewinding()) {
+		frameBuffer = _console->GetVideoRenderer()->GetFrameBuffer(frameInfo.Width, frameInfo.Height, pitch);
+	}
+
+	_videoFilter->SendFrame(_ppuOutputBuffer, _frameNumber, frameBuffer, pitch);
+
+	uint32_t* outputBuffer = _videoFilter->GetOutputBuffer();
 	_console->GetDebugHud()->Draw(outputBuffer, _videoFilter->GetOverscan(), frameInfo.Width, _frameNumber);
 
 	if(_scaleFilter) {
@@ -99,6 +108,12 @@ void VideoDecoder::DecodeFrame(bool forRewind)
 		frameInfo = _scaleFilter->GetFrameInfo(frameInfo);
 	}
 
+	_filteredBuffer = outputBuffer;
+	_lastFrameInfo = frameInfo;
+}
+
+void VideoDecoder::SendFilteredFrame(bool forRewind)
+{
 	ScreenSize screenSize = GetScreenSize(true);
 	VideoConfig config = _console->GetSettings()->GetVideoConfig();
 	if(_previousScale != config.VideoScale || screenSize.Height != _previousScreenSize.Height || screenSize.Width != _previousScreenSize.Width) {
@@ -106,12 +121,20 @@ void VideoDecoder::DecodeFrame(bool forRewind)
 	}
 	_previousScale = config.VideoScale;
 	_previousScreenSize = screenSize;
-	_lastFrameInfo = frameInfo;
 
 	//Rewind manager will take care of sending the correct frame to the video renderer
-	_console->GetRewindManager()->SendFrame(outputBuffer, frameInfo.Width, frameInfo.Height, forRewind);
+	_console->GetRewindManager()->SendFrame(_filteredBuffer, _lastFrameInfo.Width, _lastFrameInfo.Height, forRewind);
+}
 
-	_frameChanged = false;
+void VideoDecoder::DecodeFrame(bool forRewind)
+{
+	FilterFrame(forRewind);
+
+	if(_deferFrameOutput) {
+		_hasDeferredFrame = true;
+	} else {
+		SendFilteredFrame(forRewind);
+	}
 }
 
 void VideoDecoder::DecodeThread()
@@ -127,6 +150,7 @@ void VideoDecoder::DecodeThread()
 		}
 
 		DecodeFrame();
+		_frameChanged = false;
 	}
 }
 
@@ -135,7 +159,7 @@ uint32_t VideoDecoder::GetFrameCount()
 	return _frameCount;
 }
 
-void VideoDecoder::UpdateFrameSync(uint16_t *ppuOutputBuffer, uint16_t width, uint16_t height, uint32_t frameNumber, bool forRewind)
+void VideoDecoder::WaitForDecode()
 {
 	if(_frameChanged) {
 		//Last frame isn't done decoding yet - sometimes Signal() introduces a 25-30ms delay
@@ -144,8 +168,20 @@ void VideoDecoder::UpdateFrameSync(uint16_t *ppuOutputBuffer, uint16_t width, ui
 		}
 		//At this point, we are sure that the decode thread is no longer busy
 	}
+}
+
+void VideoDecoder::UpdateFrameSync(uint16_t *ppuOutputBuffer, uint16_t width, uint16_t height, uint32_t frameNumber, bool forRewind)
+{
+	WaitForDecode();
+
+	//_frameChanged is the decode thread's work signal, it must stay cleared while this thread decodes the frame
+	//Clear any signal left over from a frame the decode thread picked up without waiting, so it can't wake up during the decode
+	_waitForFrame.Reset();
+
+	//A frame still waiting to be sent by UpdateFramePipelined is dropped, this one replaces it
+	_hasDeferredFrame = false;
+	_deferFrameOutput = false;
 	
-	_frameChanged = true;
 	_baseFrameInfo.Width = width;
 	_baseFrameInfo.Height = height;
 	_frameNumber = frameNumber;
@@ -156,14 +192,38 @@ void VideoDecoder::UpdateFrameSync(uint16_t *ppuOutputBuffer, uint16_t width, ui
 
 void VideoDecoder::UpdateFrame(uint16_t *ppuOutputBuffer, uint16_t width, uint16_t height, uint32_t frameNumber)
 {
-	if(_frameChanged) {
-		//Last frame isn't done decoding yet - sometimes Signal() introduces a 25-30ms delay
-		while(_frameChanged) {
-			//Spin until decode is done
-		}
-		//At this point, we are sure that the decode thread is no longer busy
-	}
+	WaitForDecode();
 	
+	_deferFrameOutput = false;
+	_baseFrameInfo.Width = width;
+	_baseFrameInfo.Height = height;
+	_frameNumber = frameNumber;
+	_ppuOutputBuffer = ppuOutputBuffer;
+	_frameChanged = true;
+	_waitForFrame.Signal();
+
+	_frameCount++;
+}
+
+void VideoDecoder::UpdateFramePipelined(uint16_t *ppuOutputBuffer, uint16_t width, uint16_t height, uint32_t frameNumber)
+{
+	if(!_decodeThread) {
+		//Libretro builds only start the decode thread once pipelining is enabled
+		_stopFlag = false;
+		_frameChanged = false;
+		_waitForFrame.Reset();
+		_decodeThread.reset(new thread(&VideoDecoder::DecodeThread, this));
+	}
+
+	WaitForDecode();
+
+	if(_hasDeferredFrame) {
+		//Send the previous frame from the emulation thread (the libretro frontend only accepts frames during retro_run)
+		_hasDeferredFrame = false;
+		SendFilteredFrame(false);
+	}
+
+	_deferFrameOutput = true;
 	_baseFrameInfo.Width = width;
 	_baseFrameInfo.Height = height;
 	_frameNumber = frameNumber;
@@ -190,7 +250,6 @@ void VideoDecoder::StartThread()
 
 void VideoDecoder::StopThread()
 {
-#ifndef LIBRETRO
 	_stopFlag = true;
 	if(_decodeThread) {
 		_waitForFrame.Signal();
@@ -198,6 +257,12 @@ void VideoDecoder::StopThread()
 
 		_decodeThread.reset();
 
+		//The filtered frame (and the PPU buffer it was made from) may be gone by the time the next frame is sent
+		_frameChanged = false;
+		_hasDeferredFrame = false;
+		_deferFrameOutput = false;
+
+#ifndef LIBRETRO
 		//Clear whole screen
 		if(_frameCount > 0) {
 			vector<uint16_t> outputBuffer(512 * 478, 0);
@@ -206,8 +271,8 @@ void VideoDecoder::StopThread()
 			DecodeFrame();
 			_ppuOutputBuffer = nullptr;
 		}
-	}
 #endif
+	}
 }
 
 bool VideoDecoder::IsRunning()
@@ -28,6 +28,11 @@ private:
 	atomic<bool> _stopFlag;
 	uint32_t _frameCount = 0;
 
+	//When set, the decode thread only filters the frame, and UpdateFramePipelined sends it to the renderer once the next frame is done
+	bool _deferFrameOutput = false;
+	bool _hasDeferredFrame = false;
+	uint32_t* _filteredBuffer = nullptr;
+
 	ScreenSize _previousScreenSize = {};
 	double _previousScale = 0;
 	FrameInfo _baseFrameInfo;
@@ -40,6 +45,10 @@ private:
 
 	void UpdateVideoFilter();
 
+	void FilterFrame(bool forRewind);
+	void SendFilteredFrame(bool forRewind);
+	void WaitForDecode();
+
 	void DecodeThread();
 
 public:
@@ -58,6 +67,9 @@ public:
 	void UpdateFrameSync(uint16_t *ppuOutputBuffer, uint16_t width, uint16_t height, uint32_t frameNumber, bool forRewind);
 	void UpdateFrame(uint16_t *ppuOutputBuffer, uint16_t width, uint16_t height, uint32_t frameNumber);
 
+	//Sends the previous frame to the renderer, then filters this one on the decode thread while the next frame is emulated (adds 1 frame of latency)
+	void UpdateFramePipelined(uint16_t *ppuOutputBuffer, uint16_t width, uint16_t height, uint32_t frameNumber);
+
 	bool IsRunning();
 	void StartThread();
 	void StopThread();
@@ -65,6 +65,14 @@ void VideoRenderer::UpdateFrame(void* frameBuffer, uint32_t width, uint32_t heig
 	}
 }
 
+uint32_t* VideoRenderer::GetFrameBuffer(uint32_t width, uint32_t height, uint32_t &pitch)
+{
+	if(_renderer) {
+		return _renderer->GetFrameBuffer(width, height, pitch);
+	}
+	return nullptr;
+}
+
 void VideoRenderer::RegisterRenderingDevice(IRenderingDevice *renderer)
 {
 	_renderer = renderer;
@@ -31,6 +31,7 @@ public:
 	void StopThread();
 
 	void UpdateFrame(void *frameBuffer, uint32_t width, uint32_t height);
+	uint32_t* GetFrameBuffer(uint32_t width, uint32_t height, uint32_t &pitch);
 	void RegisterRenderingDevice(IRenderingDevice *renderer);
 	void UnregisterRenderingDevice(IRenderingDevice *renderer);
 
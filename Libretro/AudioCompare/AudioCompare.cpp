@@ -0,0 +1,204 @@
+//Runs the same ROM on 2 builds of the libretro core and compares their audio output, frame by frame.
+//Used to check that the batched SPC DSP/timer clocking produces the exact same samples as running
+//them on every SPC cycle (the reference core is built with SPC_PER_CYCLE_DSP, see the Makefile)
+#include <dlfcn.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../libretro.h"
+
+using std::string;
+using std::vector;
+
+struct FrameAudio
+{
+	uint64_t Hash;
+	uint32_t SampleCount;
+};
+
+static bool _idleLoopSkip = true;
+static uint32_t _frame = 0;
+static uint64_t _hash = 0;
+static uint32_t _sampleCount = 0;
+static string _folder;
+
+static bool EnvironmentCallback(unsigned cmd, void* data)
+{
+	switch(cmd) {
+		case RETRO_ENVIRONMENT_GET_VARIABLE: {
+			retro_variable* var = (retro_variable*)data;
+			if(strcmp(var->key, "mesen-s_ramstate") == 0) {
+				//Random power-on RAM would make the 2 runs differ
+				var->value = "All 0s";
+				return true;
+			} else if(strcmp(var->key, "mesen-s_idle_loop_skip") == 0) {
+				var->value = _idleLoopSkip ? "enabled" : "disabled";
+				return true;
+			}
+			return false;
+		}
+
+		case RETRO_ENVIRONMENT_GET_AUDIO_VIDEO_ENABLE:
+			//Audio only, the video output is not needed
+			*(int*)data = 0x02;
+			return true;
+
+		case RETRO_ENVIRONMENT_GET_SYSTEM_DIRECTORY:
+		case RETRO_ENVIRONMENT_GET_SAVE_DIRECTORY:
+			*(const char**)data = _folder.c_str();
+			return true;
+
+		case RETRO_ENVIRONMENT_SET_PIXEL_FORMAT:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+static void VideoCallback(const void*, unsigned, unsigned, size_t)
+{
+}
+
+static void AudioCallback(int16_t left, int16_t right)
+{
+	int16_t samples[2] = { left, right };
+	for(int i = 0; i < 2; i++) {
+		_hash = (_hash ^ (uint16_t)samples[i]) * 1099511628211ULL;
+	}
+	_sampleCount++;
+}
+
+static size_t AudioBatchCallback(const int16_t* data, size_t frames)
+{
+	for(size_t i = 0; i < frames * 2; i++) {
+		_hash = (_hash ^ (uint16_t)data[i]) * 1099511628211ULL;
+	}
+	_sampleCount += (uint32_t)frames;
+	return frames;
+}
+
+static void InputPollCallback()
+{
+}
+
+static int16_t InputStateCallback(unsigned port, unsigned device, unsigned index, unsigned id)
+{
+	if(port != 0 || device != RETRO_DEVICE_JOYPAD) {
+		return 0;
+	}
+
+	//Press a pseudo-random set of buttons for 8 frames at a time, the same for both cores, to get past title screens
+	uint32_t seed = (_frame >> 3) * 2654435761U;
+	seed ^= seed >> 15;
+	return (seed >> (id & 0x0F)) & 0x01;
+}
+
+static bool RunCore(string corePath, vector<uint8_t>& rom, string romPath, uint32_t frameCount, vector<FrameAudio>& output)
+{
+	void* core = dlopen(corePath.c_str(), RTLD_NOW | RTLD_LOCAL);
+	if(!core) {
+		printf("Could not load %s: %s\n", corePath.c_str(), dlerror());
+		return false;
+	}
+
+	#define LOAD_SYMBOL(name) auto name = (decltype(&::name))dlsym(core, #name)
+	LOAD_SYMBOL(retro_set_environment);
+	LOAD_SYMBOL(retro_init);
+	LOAD_SYMBOL(retro_set_video_refresh);
+	LOAD_SYMBOL(retro_set_audio_sample);
+	LOAD_SYMBOL(retro_set_audio_sample_batch);
+	LOAD_SYMBOL(retro_set_input_poll);
+	LOAD_SYMBOL(retro_set_input_state);
+	LOAD_SYMBOL(retro_load_game);
+	LOAD_SYMBOL(retro_run);
+	LOAD_SYMBOL(retro_unload_game);
+	LOAD_SYMBOL(retro_deinit);
+	#undef LOAD_SYMBOL
+
+	retro_set_environment(EnvironmentCallback);
+	retro_init();
+	retro_set_video_refresh(VideoCallback);
+	retro_set_audio_sample(AudioCallback);
+	retro_set_audio_sample_batch(AudioBatchCallback);
+	retro_set_input_poll(InputPollCallback);
+	retro_set_input_state(InputStateCallback);
+
+	retro_game_info gameInfo = { romPath.c_str(), rom.data(), rom.size(), nullptr };
+	if(!retro_load_game(&gameInfo)) {
+		printf("Could not load ROM: %s\n", romPath.c_str());
+		retro_deinit();
+		dlclose(core);
+		return false;
+	}
+
+	output.clear();
+	for(_frame = 0; _frame < frameCount; _frame++) {
+		_hash = 14695981039346656037ULL;
+		_sampleCount = 0;
+		retro_run();
+		output.push_back({ _hash, _sampleCount });
+	}
+
+	retro_unload_game();
+	retro_deinit();
+	dlclose(core);
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	if(argc < 4) {
+		printf("Usage: AudioCompare <reference core> <test core> <rom> [frame count] [--no-idle-skip]\n");
+		return 1;
+	}
+
+	string romPath = argv[3];
+	uint32_t frameCount = argc > 4 ? (uint32_t)strtoul(argv[4], nullptr, 10) : 10800;
+	bool testIdleLoopSkip = !(argc > 5 && strcmp(argv[5], "--no-idle-skip") == 0);
+
+	size_t separator = romPath.find_last_of("/\\");
+	_folder = separator == string::npos ? "." : romPath.substr(0, separator);
+
+	FILE* romFile = fopen(romPath.c_str(), "rb");
+	if(!romFile) {
+		printf("Could not open ROM: %s\n", romPath.c_str());
+		return 1;
+	}
+	fseek(romFile, 0, SEEK_END);
+	vector<uint8_t> rom(ftell(romFile));
+	fseek(romFile, 0, SEEK_SET);
+	size_t bytesRead = fread(rom.data(), 1, rom.size(), romFile);
+	fclose(romFile);
+	if(bytesRead != rom.size()) {
+		printf("Could not read ROM: %s\n", romPath.c_str());
+		return 1;
+	}
+
+	//The reference core always runs every SPC cycle
+	vector<FrameAudio> reference;
+	vector<FrameAudio> test;
+	_idleLoopSkip = false;
+	if(!RunCore(argv[1], rom, romPath, frameCount, reference)) {
+		return 1;
+	}
+	_idleLoopSkip = testIdleLoopSkip;
+	if(!RunCore(argv[2], rom, romPath, frameCount, test)) {
+		return 1;
+	}
+
+	uint64_t totalSamples = 0;
+	for(uint32_t i = 0; i < frameCount; i++) {
+		if(reference[i].Hash != test[i].Hash || reference[i].SampleCount != test[i].SampleCount) {
+			printf("Audio differs at frame %u (%u vs %u samples)\n", i, reference[i].SampleCount, test[i].SampleCount);
+			return 2;
+		}
+		totalSamples += reference[i].SampleCount;
+	}
+
+	printf("Audio is identical: %u frames, %llu samples\n", frameCount, (unsigned long long)totalSamples);
+	return 0;
+}
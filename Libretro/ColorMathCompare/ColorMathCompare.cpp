@@ -0,0 +1,252 @@
+//Replays the input of the PPU's color math and brightness (main/sub screen pixels, per-pixel color math flags, fixed color,
+//add/subtract mode and screen brightness for each scanline) through the scalar, SSE2 and AVX2 code of
+//Ppu::ApplyColorMathToPixels and Ppu::ApplyBrightness, checks that they produce the same pixels and reports their throughput.
+//The scanlines are captured while running a ROM (Ppu.cpp is built with PPU_COLOR_MATH_CAPTURE, see the Makefile),
+//or generated randomly when no ROM is given.
+#include "../../Core/stdafx.h"
+#include <chrono>
+#include <random>
+#include <mutex>
+#include "../../Core/Ppu.h"
+#include "../../Core/PpuTypes.h"
+#include "../libretro.h"
+
+struct ColorMathScanline
+{
+	uint16_t MainScreen[256];
+	uint16_t SubScreen[256];
+	uint8_t Flags[256];
+	uint16_t StartX;
+	uint16_t EndX;
+	uint16_t FixedColor;
+	bool Subtract;
+	uint8_t Brightness;
+};
+
+static std::mutex _captureLock;
+static vector<ColorMathScanline> _scanlines;
+static uint32_t _frame = 0;
+static string _folder;
+
+//Called by Ppu::ApplyColorMath, before the color math is applied to the main screen
+void CaptureColorMathInput(const uint16_t *mainScreen, const uint16_t *subScreen, const uint8_t *flags, uint16_t startX, uint16_t endX, uint16_t fixedColor, bool subtract, uint8_t brightness)
+{
+	ColorMathScanline scanline = {};
+	memcpy(scanline.MainScreen, mainScreen, sizeof(scanline.MainScreen));
+	memcpy(scanline.SubScreen, subScreen, sizeof(scanline.SubScreen));
+	memcpy(scanline.Flags + startX, flags + startX, endX - startX + 1);
+	scanline.StartX = startX;
+	scanline.EndX = endX;
+	scanline.FixedColor = fixedColor;
+	scanline.Subtract = subtract;
+	scanline.Brightness = brightness;
+
+	std::lock_guard<std::mutex> lock(_captureLock);
+	_scanlines.push_back(scanline);
+}
+
+static bool EnvironmentCallback(unsigned cmd, void* data)
+{
+	switch(cmd) {
+		case RETRO_ENVIRONMENT_GET_SYSTEM_DIRECTORY:
+		case RETRO_ENVIRONMENT_GET_SAVE_DIRECTORY:
+			*(const char**)data = _folder.c_str();
+			return true;
+
+		case RETRO_ENVIRONMENT_SET_PIXEL_FORMAT:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+static void VideoCallback(const void*, unsigned, unsigned, size_t) {}
+static void AudioCallback(int16_t, int16_t) {}
+static size_t AudioBatchCallback(const int16_t*, size_t frames) { return frames; }
+static void InputPollCallback() {}
+
+static int16_t InputStateCallback(unsigned port, unsigned device, unsigned index, unsigned id)
+{
+	if(port != 0 || device != RETRO_DEVICE_JOYPAD) {
+		return 0;
+	}
+
+	//Press a pseudo-random set of buttons for 8 frames at a time to get past title screens
+	uint32_t seed = (_frame >> 3) * 2654435761U;
+	seed ^= seed >> 15;
+	return (seed >> (id & 0x0F)) & 0x01;
+}
+
+static bool CaptureFromRom(string romPath, uint32_t frameCount)
+{
+	size_t separator = romPath.find_last_of("/\\");
+	_folder = separator == string::npos ? "." : romPath.substr(0, separator);
+
+	ifstream romFile(romPath, ios::in | ios::binary);
+	if(!romFile) {
+		std::cout << "Could not open ROM: " << romPath << std::endl;
+		return false;
+	}
+	vector<uint8_t> rom((std::istreambuf_iterator<char>(romFile)), std::istreambuf_iterator<char>());
+
+	retro_set_environment(EnvironmentCallback);
+	retro_init();
+	retro_set_video_refresh(VideoCallback);
+	retro_set_audio_sample(AudioCallback);
+	retro_set_audio_sample_batch(AudioBatchCallback);
+	retro_set_input_poll(InputPollCallback);
+	retro_set_input_state(InputStateCallback);
+
+	retro_game_info gameInfo = { romPath.c_str(), rom.data(), rom.size(), nullptr };
+	if(!retro_load_game(&gameInfo)) {
+		std::cout << "Could not load ROM: " << romPath << std::endl;
+		retro_deinit();
+		return false;
+	}
+
+	for(_frame = 0; _frame < frameCount; _frame++) {
+		retro_run();
+	}
+
+	retro_unload_game();
+	retro_deinit();
+	return true;
+}
+
+static void GenerateScanlines(uint32_t count)
+{
+	std::mt19937 rng(1);
+	for(uint32_t i = 0; i < count; i++) {
+		ColorMathScanline scanline = {};
+		for(int x = 0; x < 256; x++) {
+			scanline.MainScreen[x] = rng() & 0x7FFF;
+			scanline.SubScreen[x] = rng() & 0x7FFF;
+			scanline.Flags[x] = rng() & (ColorMathFlags::ClipToBlack | ColorMathFlags::ApplyColorMath | ColorMathFlags::HalveResult | ColorMathFlags::UseSubScreen);
+		}
+
+		//Most scanlines are drawn in full, the rest cover the partial spans drawn when registers change mid-scanline
+		uint16_t start = rng() & 0xFF;
+		uint16_t end = rng() & 0xFF;
+		bool fullScanline = (rng() & 0x03) != 0;
+		scanline.StartX = fullScanline ? 0 : std::min(start, end);
+		scanline.EndX = fullScanline ? 255 : std::max(start, end);
+		scanline.FixedColor = rng() & 0x7FFF;
+		scanline.Subtract = (rng() & 0x01) != 0;
+		scanline.Brightness = rng() & 0x0F;
+		_scanlines.push_back(scanline);
+	}
+}
+
+class ColorMathCompare
+{
+private:
+	struct Kernel
+	{
+		const char* Name;
+		bool UseSse2;
+		bool UseAvx2;
+	};
+
+	//Same steps as Ppu::RenderScanline: color math on the main screen, followed by the brightness
+	static void ApplyScanline(Ppu *ppu, const ColorMathScanline &scanline, uint16_t *output)
+	{
+		ppu->_state.FixedColor = scanline.FixedColor;
+		ppu->_state.ColorMathSubstractMode = scanline.Subtract;
+		ppu->_state.ScreenBrightness = scanline.Brightness;
+		ppu->_drawStartX = scanline.StartX;
+		ppu->_drawEndX = scanline.EndX;
+
+		memcpy(ppu->_mainScreenBuffer, scanline.MainScreen, sizeof(ppu->_mainScreenBuffer));
+		int count = scanline.EndX - scanline.StartX + 1;
+		ppu->ApplyColorMathToPixels(ppu->_mainScreenBuffer + scanline.StartX, scanline.SubScreen + scanline.StartX, scanline.Flags + scanline.StartX, count);
+		ppu->ApplyBrightness<true>();
+		memcpy(output, ppu->_mainScreenBuffer + scanline.StartX, count * sizeof(uint16_t));
+	}
+
+public:
+	static int Run(uint32_t iterations)
+	{
+		//The PPU's constructor only allocates its buffers, the console isn't needed to apply the color math
+		unique_ptr<Ppu> ppu(new Ppu(nullptr));
+		bool hasAvx2 = ppu->_useAvx2;
+
+		vector<Kernel> kernels = {
+			{ "Scalar", false, false },
+			{ "SSE2", true, false },
+			{ "AVX2", true, true }
+		};
+
+		uint64_t pixelCount = 0;
+		for(ColorMathScanline &scanline : _scanlines) {
+			pixelCount += scanline.EndX - scanline.StartX + 1;
+		}
+
+		vector<uint16_t> expected(_scanlines.size() * 256);
+		vector<uint16_t> output(_scanlines.size() * 256);
+		uint32_t mismatchCount = 0;
+
+		std::cout << _scanlines.size() << " scanlines (" << pixelCount << " pixels), million pixels per second:" << std::endl;
+		for(Kernel &kernel : kernels) {
+			if(kernel.UseAvx2 && !hasAvx2) {
+				std::cout << "  " << kernel.Name << ": not supported by this CPU" << std::endl;
+				continue;
+			}
+
+			ppu->_useSse2 = kernel.UseSse2;
+			ppu->_useAvx2 = kernel.UseAvx2;
+			uint16_t *target = kernel.UseSse2 ? output.data() : expected.data();
+
+			auto start = std::chrono::high_resolution_clock::now();
+			for(uint32_t n = 0; n < iterations; n++) {
+				for(size_t i = 0; i < _scanlines.size(); i++) {
+					ApplyScanline(ppu.get(), _scanlines[i], target + i * 256);
+				}
+			}
+			std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+			std::cout << "  " << kernel.Name << ": " << std::fixed << std::setprecision(1) << pixelCount * iterations / elapsed.count() / 1000000;
+
+			if(target == output.data()) {
+				uint32_t kernelMismatches = 0;
+				for(size_t i = 0; i < _scanlines.size(); i++) {
+					int count = _scanlines[i].EndX - _scanlines[i].StartX + 1;
+					if(memcmp(output.data() + i * 256, expected.data() + i * 256, count * sizeof(uint16_t)) != 0) {
+						kernelMismatches++;
+					}
+				}
+				if(kernelMismatches) {
+					std::cout << " (" << kernelMismatches << " scanlines differ from the scalar code)";
+				}
+				mismatchCount += kernelMismatches;
+			}
+			std::cout << std::endl;
+		}
+
+		std::cout << (mismatchCount ? "FAILED" : "All kernels are identical to the scalar code") << std::endl;
+		return mismatchCount ? 1 : 0;
+	}
+};
+
+int main(int argc, char* argv[])
+{
+	if(argc < 2) {
+		std::cout << "Usage: ColorMathCompare <iterations> [rom] [frame count]" << std::endl;
+		return 1;
+	}
+
+	uint32_t iterations = (uint32_t)strtoul(argv[1], nullptr, 10);
+	if(argc > 2) {
+		uint32_t frameCount = argc > 3 ? (uint32_t)strtoul(argv[3], nullptr, 10) : 1800;
+		if(!CaptureFromRom(argv[2], frameCount)) {
+			return 1;
+		}
+		if(_scanlines.empty()) {
+			std::cout << "The ROM didn't use color math or brightness (no scanlines captured)" << std::endl;
+			return 1;
+		}
+	} else {
+		GenerateScanlines(20000);
+	}
+
+	return ColorMathCompare::Run(iterations);
+}
@@ -0,0 +1,188 @@
+//Runs a fixed mix of 65816 instructions (8 and 16-bit modes, REP/SEP mode switches, direct page, absolute, long and indexed
+//accesses, branches, stack and subroutine calls) through Cpu and Sa1Cpu and prints the number of instructions per second.
+//The program is placed in a generated ROM (a plain LoROM for Cpu, an SA-1 ROM for Sa1Cpu) that is loaded by the console,
+//so memory accesses go through the same mappings and handlers as they do in games.
+#include "../../Core/stdafx.h"
+#include <chrono>
+#include "../../Core/Console.h"
+#include "../../Core/BaseCartridge.h"
+#include "../../Core/CartTypes.h"
+#include "../../Core/Cpu.h"
+#include "../../Core/Sa1.h"
+#include "../../Core/Sa1Cpu.h"
+#include "../../Utilities/VirtualFile.h"
+#include "../../Utilities/HexUtilities.h"
+
+class CpuBench
+{
+private:
+	static constexpr uint32_t RomSize = 0x8000;
+	static size_t _programSize;
+
+	//The same program runs on both CPUs: $0000-$07FF is work RAM for Cpu and the SA-1's internal RAM for Sa1Cpu
+	static vector<uint8_t> BuildProgram(uint16_t &resetVector)
+	{
+		vector<uint8_t> code;
+		auto emit = [&code](std::initializer_list<uint8_t> bytes) { code.insert(code.end(), bytes); };
+		auto branch = [&code](uint8_t opCode, size_t target) {
+			code.push_back(opCode);
+			code.push_back((uint8_t)(target - (code.size() + 1)));
+		};
+
+		//Subroutine (16-bit), called from the main loop
+		size_t sub = code.size();
+		emit({ 0x08 });                   //PHP
+		emit({ 0xC2, 0x30 });             //REP #$30
+		emit({ 0xA5, 0x14 });             //LDA $14
+		emit({ 0x1A });                   //INC A
+		emit({ 0x85, 0x14 });             //STA $14
+		emit({ 0x28 });                   //PLP
+		emit({ 0x60 });                   //RTS
+
+		//Switch to native mode, set up the stack and direct page
+		resetVector = (uint16_t)(0x8000 + code.size());
+		emit({ 0x18 });                   //CLC
+		emit({ 0xFB });                   //XCE
+		emit({ 0xC2, 0x30 });             //REP #$30
+		emit({ 0xA2, 0xFF, 0x01 });       //LDX #$01FF
+		emit({ 0x9A });                   //TXS
+		emit({ 0xA9, 0x00, 0x00 });       //LDA #$0000
+		emit({ 0x5B });                   //TCD
+
+		size_t loop = code.size();
+		emit({ 0xC2, 0x30 });             //REP #$30
+		emit({ 0xA9, 0x34, 0x12 });       //LDA #$1234
+		emit({ 0x18 });                   //CLC
+		emit({ 0x65, 0x10 });             //ADC $10
+		emit({ 0x85, 0x10 });             //STA $10
+		emit({ 0xA2, 0x08, 0x00 });       //LDX #$0008
+		size_t loop16 = code.size();
+		emit({ 0xBD, 0x00, 0x03 });       //LDA $0300,X
+		emit({ 0x49, 0x55, 0xAA });       //EOR #$AA55
+		emit({ 0x9D, 0x00, 0x03 });       //STA $0300,X
+		emit({ 0xCA });                   //DEX
+		emit({ 0xCA });                   //DEX
+		branch(0x10, loop16);             //BPL loop16
+
+		emit({ 0xE2, 0x20 });             //SEP #$20
+		emit({ 0xA5, 0x12 });             //LDA $12
+		emit({ 0x0A });                   //ASL A
+		emit({ 0x85, 0x12 });             //STA $12
+		emit({ 0xAF, 0x20, 0x03, 0x00 }); //LDA $000320
+		emit({ 0x1A });                   //INC A
+		emit({ 0x8F, 0x20, 0x03, 0x00 }); //STA $000320
+		emit({ 0xE2, 0x10 });             //SEP #$10
+		emit({ 0xA0, 0x10 });             //LDY #$10
+		size_t loop8 = code.size();
+		emit({ 0xB9, 0x40, 0x03 });       //LDA $0340,Y
+		emit({ 0x69, 0x03 });             //ADC #$03
+		emit({ 0x99, 0x40, 0x03 });       //STA $0340,Y
+		emit({ 0x88 });                   //DEY
+		branch(0xD0, loop8);              //BNE loop8
+
+		emit({ 0x48 });                   //PHA
+		emit({ 0x20, (uint8_t)sub, (uint8_t)(0x80 | (sub >> 8)) }); //JSR sub
+		emit({ 0x68 });                   //PLA
+		emit({ 0xC2, 0x20 });             //REP #$20
+		emit({ 0xEB });                   //XBA
+		emit({ 0x4C, (uint8_t)loop, (uint8_t)(0x80 | (loop >> 8)) }); //JMP loop
+		_programSize = code.size();
+		return code;
+	}
+
+	static vector<uint8_t> BuildRom(bool sa1)
+	{
+		uint16_t resetVector;
+		vector<uint8_t> code = BuildProgram(resetVector);
+		vector<uint8_t> rom(RomSize, 0);
+		std::copy(code.begin(), code.end(), rom.begin());
+
+		SnesCartInformation header = {};
+		memcpy(header.CartName, "CPU BENCHMARK        ", sizeof(header.CartName));
+		header.MapMode = sa1 ? 0x23 : 0x20;
+		header.RomType = sa1 ? 0x34 : 0x00;
+		header.RomSize = 0x05;
+
+		uint16_t checksum = 0;
+		for(uint8_t value : rom) {
+			checksum += value;
+		}
+		header.Checksum[0] = (uint8_t)checksum;
+		header.Checksum[1] = (uint8_t)(checksum >> 8);
+		header.ChecksumComplement[0] = (uint8_t)~checksum;
+		header.ChecksumComplement[1] = (uint8_t)(~checksum >> 8);
+
+		//Emulation mode reset vector at $FFFC
+		header.CpuVectors[0x1C] = (uint8_t)resetVector;
+		header.CpuVectors[0x1D] = (uint8_t)(resetVector >> 8);
+		memcpy(rom.data() + 0x7FB0, &header, sizeof(header));
+		return rom;
+	}
+
+	static bool LoadRom(shared_ptr<Console> &console, bool sa1)
+	{
+		vector<uint8_t> rom = BuildRom(sa1);
+		VirtualFile romFile(rom.data(), rom.size(), sa1 ? "CpuBenchSa1.sfc" : "CpuBench.sfc");
+		if(!console->LoadRom(romFile, VirtualFile())) {
+			std::cout << "Could not load the generated " << (sa1 ? "SA-1 " : "") << "ROM" << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	template<typename T>
+	static bool Run(const char* name, T* cpu, uint32_t instructionCount)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+		for(uint32_t i = 0; i < instructionCount; i++) {
+			cpu->Exec();
+		}
+		std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+		std::cout << "  " << name << ": " << std::fixed << std::setprecision(2) << instructionCount / elapsed.count() / 1000000 << " million instructions per second" << std::endl;
+
+		//Make sure the numbers above come from the benchmark's loop (e.g not from an unexpected BRK or STP)
+		CpuState state = cpu->GetState();
+		if(state.K != 0 || state.PC < 0x8000 || state.PC >= 0x8000 + _programSize || state.EmulationMode || state.StopState != CpuStopState::Running) {
+			std::cout << "  " << name << " left the benchmark's program (PC: $" << HexUtilities::ToHex(state.K) << HexUtilities::ToHex(state.PC) << ")" << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+public:
+	static int Run(uint32_t instructionCount)
+	{
+		shared_ptr<Console> console(new Console());
+		console->Initialize();
+
+		std::cout << instructionCount << " instructions:" << std::endl;
+
+		if(!LoadRom(console, false)) {
+			console->Release();
+			return 1;
+		}
+		bool result = Run("Cpu", console->GetCpu().get(), instructionCount);
+
+		if(!LoadRom(console, true)) {
+			console->Release();
+			return 1;
+		}
+
+		//The SA-1 CPU is held in reset until the S-CPU starts it, start it directly at the program's reset vector
+		Sa1* sa1 = console->GetCartridge()->GetSa1();
+		sa1->_state.Sa1ResetVector = console->GetCpu()->GetState().PC;
+		sa1->_cpu->Reset();
+		result &= Run("Sa1Cpu", sa1->_cpu.get(), instructionCount);
+
+		console->Release();
+		return result ? 0 : 1;
+	}
+};
+
+size_t CpuBench::_programSize = 0;
+
+int main(int argc, char* argv[])
+{
+	uint32_t instructionCount = argc > 1 ? (uint32_t)strtoul(argv[1], nullptr, 10) : 50000000;
+	return CpuBench::Run(instructionCount);
+}
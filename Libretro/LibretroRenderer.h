@@ -16,6 +16,26 @@ private:
 	int32_t _previousHeight = -1;
 	int32_t _previousWidth = -1;
 
+	//Frontend buffer returned by GetFrameBuffer for the current frame
+	uint32_t* _frameBuffer = nullptr;
+	size_t _frameBufferPitch = 0;
+
+	void UpdateGeometry(uint32_t width, uint32_t height)
+	{
+		//Use Blargg's NTSC filter's max size as a minimum resolution, to prevent changing resolution too often
+		int32_t newWidth = std::max<int32_t>(width, SNES_NTSC_OUT_WIDTH(256));
+		int32_t newHeight = std::max<int32_t>(height, 239 * 2);
+		if(_retroEnv != nullptr && (_previousWidth != newWidth || _previousHeight != newHeight)) {
+			//Resolution change is needed
+			retro_system_av_info avInfo = {};
+			GetSystemAudioVideoInfo(avInfo, newWidth, newHeight);
+			_retroEnv(RETRO_ENVIRONMENT_SET_SYSTEM_AV_INFO, &avInfo);
+
+			_previousWidth = newWidth;
+			_previousHeight = newHeight;
+		}
+	}
+
 public:
 	LibretroRenderer(shared_ptr<Console> console, retro_environment_t retroEnv)
 	{
@@ -33,21 +53,37 @@ public:
 	virtual void UpdateFrame(void *frameBuffer, uint32_t width, uint32_t height) override
 	{
 		if(!_skipMode && _sendFrame) {
-			//Use Blargg's NTSC filter's max size as a minimum resolution, to prevent changing resolution too often
-			int32_t newWidth = std::max<int32_t>(width, SNES_NTSC_OUT_WIDTH(256));
-			int32_t newHeight = std::max<int32_t>(height, 239 * 2);
-			if(_retroEnv != nullptr && (_previousWidth != newWidth || _previousHeight != newHeight)) {
-				//Resolution change is needed
-				retro_system_av_info avInfo = {};
-				GetSystemAudioVideoInfo(avInfo, newWidth, newHeight);
-				_retroEnv(RETRO_ENVIRONMENT_SET_SYSTEM_AV_INFO, &avInfo);
-				
-				_previousWidth = newWidth;
-				_previousHeight = newHeight;
-			}
+			UpdateGeometry(width, height);
 
-			_sendFrame(frameBuffer, width, height, sizeof(uint32_t) * width);
+			size_t pitch = frameBuffer == _frameBuffer ? _frameBufferPitch : sizeof(uint32_t) * width;
+			_sendFrame(frameBuffer, width, height, pitch);
+		}
+		_frameBuffer = nullptr;
+	}
+
+	virtual uint32_t* GetFrameBuffer(uint32_t width, uint32_t height, uint32_t &pitch) override
+	{
+		//Let the video filter write the frame directly into the frontend's memory, when the frontend supports it
+		_frameBuffer = nullptr;
+		if(_skipMode || !_sendFrame || !_retroEnv) {
+			return nullptr;
+		}
+
+		//The frontend's buffer must be large enough for the frame, update the geometry before requesting it
+		UpdateGeometry(width, height);
+
+		retro_framebuffer fb = {};
+		fb.width = width;
+		fb.height = height;
+		fb.access_flags = RETRO_MEMORY_ACCESS_WRITE;
+		if(_retroEnv(RETRO_ENVIRONMENT_GET_CURRENT_SOFTWARE_FRAMEBUFFER, &fb) && fb.data && fb.format == RETRO_PIXEL_FORMAT_XRGB8888) {
+			if(fb.pitch >= width * sizeof(uint32_t) && (fb.pitch % sizeof(uint32_t)) == 0) {
+				_frameBuffer = (uint32_t*)fb.data;
+				_frameBufferPitch = fb.pitch;
+				pitch = (uint32_t)(fb.pitch / sizeof(uint32_t));
+			}
 		}
+		return _frameBuffer;
 	}
 	
 	void GetSystemAudioVideoInfo(retro_system_av_info &info, int32_t maxWidth = 0, int32_t maxHeight = 0)
@@ -0,0 +1,69 @@
+//Differential test of Ppu::FetchMode7Pixels (SIMD) against the per-pixel GetMode7Pixel code it replaced,
+//using random VRAM contents, map settings, affine coordinates/steps and draw spans.
+#include "../../Core/stdafx.h"
+#include <random>
+#include "../../Core/Ppu.h"
+
+class Mode7FetchTest
+{
+public:
+	static uint64_t Run(uint32_t iterations, uint32_t seed)
+	{
+		//The PPU's constructor only allocates its buffers, the console isn't needed to fetch mode 7 pixels
+		unique_ptr<Ppu> ppu(new Ppu(nullptr));
+		std::mt19937 rng(seed);
+
+		uint16_t pixels[256];
+		uint16_t expected[256];
+		uint64_t mismatches = 0;
+		uint64_t pixelCount = 0;
+
+		for(uint32_t i = 0; i < iterations; i++) {
+			if((i & 0x3FF) == 0) {
+				for(uint32_t j = 0; j < (Ppu::VideoRamSize >> 1); j++) {
+					ppu->_vram[j] = (uint16_t)rng();
+				}
+			}
+
+			ppu->_state.Mode7.LargeMap = rng() & 0x01;
+			ppu->_state.Mode7.FillWithTile0 = rng() & 0x01;
+
+			//Same ranges as RenderTilemapMode7: the 16-bit matrix values are the steps, the start coordinates
+			//come from 13-bit scroll/center values multiplied by the matrix
+			int16_t xStep = (int16_t)rng();
+			int16_t yStep = (int16_t)rng();
+			int32_t xValue = (int32_t)(rng() & 0xFFFFFFF) - 0x8000000;
+			int32_t yValue = (int32_t)(rng() & 0xFFFFFFF) - 0x8000000;
+
+			uint16_t start = rng() & 0xFF;
+			uint16_t end = rng() & 0xFF;
+			ppu->_drawStartX = std::min(start, end);
+			ppu->_drawEndX = std::max(start, end);
+
+			ppu->FetchMode7Pixels(xValue, yValue, xStep, yStep, pixels);
+			ppu->FetchMode7PixelsScalar(xValue, yValue, xStep, yStep, expected, ppu->_drawStartX);
+
+			for(int x = ppu->_drawStartX; x <= ppu->_drawEndX; x++) {
+				if(pixels[x] != expected[x]) {
+					if(mismatches < 10) {
+						std::cout << "Mismatch at x=" << x << " (start " << xValue << "," << yValue << " step " << xStep << "," << yStep <<
+							" LargeMap " << ppu->_state.Mode7.LargeMap << " FillWithTile0 " << ppu->_state.Mode7.FillWithTile0 << "): " <<
+							pixels[x] << " vs " << expected[x] << std::endl;
+					}
+					mismatches++;
+				}
+			}
+			pixelCount += ppu->_drawEndX - ppu->_drawStartX + 1;
+		}
+
+		std::cout << pixelCount << " pixels compared, " << mismatches << " mismatches" << std::endl;
+		return mismatches;
+	}
+};
+
+int main(int argc, char* argv[])
+{
+	uint32_t iterations = argc > 1 ? (uint32_t)strtoul(argv[1], nullptr, 10) : 1000000;
+	uint32_t seed = argc > 2 ? (uint32_t)strtoul(argv[2], nullptr, 10) : 1;
+	return Mode7FetchTest::Run(iterations, seed) ? 1 : 0;
+}
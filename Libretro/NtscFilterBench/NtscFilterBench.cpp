@@ -0,0 +1,129 @@
+//Benchmark of the NTSC filter's blitters (snes_ntsc_blit/snes_ntsc_blit_hires) split into 1 to N bands of rows,
+//the same way NtscFilter::ApplyFilter splits them over the thread pool. The output of every preset/burst phase is
+//compared with the scalar SNES_NTSC_RGB_OUT blitters (snes_ntsc.cpp built with SNES_NTSC_NO_SIMD, see the Makefile).
+#include "../../Core/stdafx.h"
+#include <chrono>
+#include <random>
+#include "../../Utilities/snes_ntsc.h"
+#include "../../Utilities/ThreadPool.h"
+
+//Scalar copy of the blitters, renamed by the Makefile
+extern "C" {
+	void snes_ntsc_blit_scalar(snes_ntsc_t const* ntsc, SNES_NTSC_IN_T const* input, long in_row_width, int burst_phase, int in_width, int in_height, void* rgb_out, long out_pitch);
+	void snes_ntsc_blit_hires_scalar(snes_ntsc_t const* ntsc, SNES_NTSC_IN_T const* input, long in_row_width, int burst_phase, int in_width, int in_height, void* rgb_out, long out_pitch);
+}
+
+typedef void (*BlitFunc)(snes_ntsc_t const* ntsc, SNES_NTSC_IN_T const* input, long in_row_width, int burst_phase, int in_width, int in_height, void* rgb_out, long out_pitch);
+
+class NtscFilterBench
+{
+private:
+	static constexpr uint32_t MinBandHeight = 16;
+	static constexpr uint32_t BaseWidth = SNES_NTSC_OUT_WIDTH(256);
+
+	//Same band split, burst phase and output pitch as NtscFilter::ApplyFilter
+	static void BlitFrame(ThreadPool *pool, BlitFunc blit, bool hiRes, snes_ntsc_t const* ntsc, uint16_t *in, uint32_t *out, uint32_t height, int burstPhase)
+	{
+		uint32_t bandCount = pool ? std::max<uint32_t>(1, std::min<uint32_t>(pool->GetThreadCount(), height / MinBandHeight)) : 1;
+		auto blitBand = [=](uint32_t band) {
+			uint32_t yFirst = height * band / bandCount;
+			uint32_t yLast = height * (band + 1) / bandCount;
+			int bandBurstPhase = (burstPhase + yFirst) % snes_ntsc_burst_count;
+			if(hiRes) {
+				blit(ntsc, in + yFirst * 512, 512, bandBurstPhase, 512, yLast - yFirst, out + yFirst * BaseWidth, BaseWidth * 4);
+			} else {
+				blit(ntsc, in + yFirst * 256, 256, bandBurstPhase, 256, yLast - yFirst, out + yFirst * BaseWidth * 2, BaseWidth * 8);
+			}
+		};
+
+		if(pool) {
+			pool->Run(bandCount, blitBand);
+		} else {
+			blitBand(0);
+		}
+	}
+
+	static uint32_t Compare(ThreadPool *pool, snes_ntsc_t const* ntsc, bool hiRes, uint16_t *in, uint32_t height, const char* presetName)
+	{
+		vector<uint32_t> expected(BaseWidth * 480);
+		vector<uint32_t> output(BaseWidth * 480);
+		uint32_t mismatchCount = 0;
+
+		for(int burstPhase = 0; burstPhase < snes_ntsc_burst_count; burstPhase++) {
+			BlitFrame(nullptr, hiRes ? snes_ntsc_blit_hires_scalar : snes_ntsc_blit_scalar, hiRes, ntsc, in, expected.data(), height, burstPhase);
+			BlitFrame(pool, hiRes ? snes_ntsc_blit_hires : snes_ntsc_blit, hiRes, ntsc, in, output.data(), height, burstPhase);
+			if(memcmp(expected.data(), output.data(), output.size() * sizeof(uint32_t)) != 0) {
+				std::cout << "Mismatch: " << presetName << (hiRes ? " hi-res" : " low-res") << ", burst phase " << burstPhase << std::endl;
+				mismatchCount++;
+			}
+		}
+		return mismatchCount;
+	}
+
+public:
+	static int Run(uint32_t frames, uint32_t maxThreads)
+	{
+		std::mt19937 rng(1);
+		vector<uint16_t> frame(512 * 478);
+		for(size_t i = 0; i < frame.size(); i++) {
+			frame[i] = rng() & 0x7FFF;
+		}
+
+		const snes_ntsc_setup_t* presets[] = { &snes_ntsc_composite, &snes_ntsc_svideo, &snes_ntsc_rgb, &snes_ntsc_monochrome };
+		const char* presetNames[] = { "composite", "svideo", "rgb", "monochrome" };
+
+		//The output is compared with the rows split into as many bands as the largest thread count
+		unique_ptr<ThreadPool> comparePool(new ThreadPool(maxThreads - 1));
+		unique_ptr<snes_ntsc_t> ntsc(new snes_ntsc_t());
+		uint32_t mismatchCount = 0;
+		for(int i = 0; i < 4; i++) {
+			snes_ntsc_init(ntsc.get(), presets[i]);
+			mismatchCount += Compare(comparePool.get(), ntsc.get(), false, frame.data(), 239, presetNames[i]);
+			mismatchCount += Compare(comparePool.get(), ntsc.get(), true, frame.data(), 478, presetNames[i]);
+		}
+		std::cout << (mismatchCount ? "FAILED" : "Output is identical to the scalar blitters") << " (4 presets, 3 burst phases, low-res and hi-res, " << maxThreads << " band(s))" << std::endl;
+		comparePool.reset();
+
+		snes_ntsc_init(ntsc.get(), &snes_ntsc_composite);
+		vector<uint32_t> output(BaseWidth * 480);
+
+		std::cout << "Frames per second (" << frames << " frames):" << std::endl;
+		std::cout << "  Scalar, 1 band: ";
+		for(int hiRes = 0; hiRes < 2; hiRes++) {
+			auto start = std::chrono::high_resolution_clock::now();
+			for(uint32_t n = 0; n < frames; n++) {
+				BlitFrame(nullptr, hiRes ? snes_ntsc_blit_hires_scalar : snes_ntsc_blit_scalar, hiRes, ntsc.get(), frame.data(), output.data(), hiRes ? 478 : 239, n % snes_ntsc_burst_count);
+			}
+			std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+			std::cout << (hiRes ? "  hi-res " : "low-res ") << std::fixed << std::setprecision(1) << frames / elapsed.count();
+		}
+		std::cout << std::endl;
+
+		for(uint32_t threadCount = 1; threadCount <= maxThreads; threadCount++) {
+			//The calling thread runs tasks too, so N threads = N - 1 workers
+			ThreadPool pool(threadCount - 1);
+			std::cout << "  " << threadCount << " thread(s):    ";
+			for(int hiRes = 0; hiRes < 2; hiRes++) {
+				auto start = std::chrono::high_resolution_clock::now();
+				for(uint32_t n = 0; n < frames; n++) {
+					BlitFrame(&pool, hiRes ? snes_ntsc_blit_hires : snes_ntsc_blit, hiRes, ntsc.get(), frame.data(), output.data(), hiRes ? 478 : 239, n % snes_ntsc_burst_count);
+				}
+				std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+				std::cout << (hiRes ? "  hi-res " : "low-res ") << std::fixed << std::setprecision(1) << frames / elapsed.count();
+			}
+			std::cout << std::endl;
+		}
+
+		return mismatchCount ? 1 : 0;
+	}
+};
+
+int main(int argc, char* argv[])
+{
+	uint32_t frames = argc > 1 ? (uint32_t)strtoul(argv[1], nullptr, 10) : 300;
+	uint32_t maxThreads = argc > 2 ? (uint32_t)strtoul(argv[2], nullptr, 10) : 0;
+	if(maxThreads == 0) {
+		maxThreads = std::max<uint32_t>(1, std::min<uint32_t>(16, std::thread::hardware_concurrency()));
+	}
+	return NtscFilterBench::Run(frames, maxThreads);
+}
@@ -0,0 +1,116 @@
+//Benchmark of DefaultVideoFilter::DecodeRow's scalar, SSE2 and AVX2 paths over 256x239 and 512x478 frames,
+//with and without GB frame blending. Each path's output is compared with the scalar palette lookup (the reference).
+#include "../../Core/stdafx.h"
+#include <chrono>
+#include <random>
+#include "../../Core/Console.h"
+#include "../../Core/EmuSettings.h"
+#include "../../Core/SettingTypes.h"
+#include "../../Core/DefaultVideoFilter.h"
+
+class VideoFilterBench
+{
+private:
+	struct DecodePath
+	{
+		const char* Name;
+		bool UseAvx2;
+		bool DirectColors;
+	};
+
+	static double DecodeFrame(DefaultVideoFilter &filter, uint32_t *out, const uint16_t *in, const uint16_t *prevIn, uint32_t width, uint32_t height, uint32_t iterations)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+		for(uint32_t n = 0; n < iterations; n++) {
+			for(uint32_t i = 0; i < height; i++) {
+				filter.DecodeRow(out + i * width, in + i * width, prevIn ? prevIn + i * width : nullptr, width);
+			}
+		}
+		std::chrono::duration<double, std::micro> elapsed = std::chrono::high_resolution_clock::now() - start;
+		return elapsed.count() / iterations;
+	}
+
+public:
+	static int Run(uint32_t iterations)
+	{
+		shared_ptr<Console> console(new Console());
+		console->Initialize();
+
+		unique_ptr<DefaultVideoFilter> filter(new DefaultVideoFilter(console));
+		bool hasAvx2 = filter->_useAvx2;
+
+		//Scalar: palette lookup (the reference). SSE2/AVX2 direct: bit expansion without the palette (only valid with
+		//the neutral palette). AVX2 gather: palette lookup, 8 entries at a time.
+		vector<DecodePath> paths = {
+			{ "Scalar", false, false },
+			{ "SSE2 direct", false, true },
+			{ "AVX2 direct", true, true },
+			{ "AVX2 gather", true, false }
+		};
+
+		std::mt19937 rng(1);
+		vector<uint16_t> frame(512 * 478);
+		vector<uint16_t> prevFrame(512 * 478);
+		for(size_t i = 0; i < frame.size(); i++) {
+			frame[i] = rng() & 0x7FFF;
+			prevFrame[i] = rng() & 0x7FFF;
+		}
+
+		vector<uint32_t> expected(512 * 478);
+		vector<uint32_t> output(512 * 478);
+		uint32_t mismatchCount = 0;
+
+		for(int adjustedPalette = 0; adjustedPalette < 2; adjustedPalette++) {
+			VideoConfig cfg = console->GetSettings()->GetVideoConfig();
+			cfg.Hue = adjustedPalette ? 0.25 : 0;
+			cfg.Saturation = adjustedPalette ? 0.5 : 0;
+			console->GetSettings()->SetVideoConfig(cfg);
+			filter->InitLookupTable();
+
+			std::cout << (adjustedPalette ? "Adjusted palette (hue/saturation)" : "Neutral palette") << ", us per frame:" << std::endl;
+
+			for(uint32_t size = 0; size < 2; size++) {
+				uint32_t width = size ? 512 : 256;
+				uint32_t height = size ? 478 : 239;
+
+				for(int blend = 0; blend < 2; blend++) {
+					const uint16_t* prevIn = blend ? prevFrame.data() : nullptr;
+					std::cout << "  " << width << "x" << height << (blend ? " blended" : "        ");
+
+					for(DecodePath &path : paths) {
+						if((path.UseAvx2 && !hasAvx2) || (path.DirectColors && adjustedPalette)) {
+							continue;
+						}
+
+						filter->_useAvx2 = path.UseAvx2;
+						filter->_directColors = path.DirectColors;
+						uint32_t *target = path.DirectColors || path.UseAvx2 ? output.data() : expected.data();
+						double usPerFrame = DecodeFrame(*filter, target, frame.data(), prevIn, width, height, iterations);
+
+						if(target == output.data() && memcmp(output.data(), expected.data(), width * height * sizeof(uint32_t)) != 0) {
+							std::cout << std::endl << "Mismatch: " << path.Name << " (" << width << "x" << height << (blend ? " blended" : "") << ")" << std::endl;
+							mismatchCount++;
+						}
+						std::cout << "  " << path.Name << ": " << std::fixed << std::setprecision(1) << usPerFrame;
+					}
+					std::cout << std::endl;
+				}
+			}
+		}
+
+		if(!hasAvx2) {
+			std::cout << "AVX2 is not supported by this CPU, the AVX2 paths were skipped" << std::endl;
+		}
+		std::cout << (mismatchCount ? "FAILED" : "All paths are identical to the scalar reference") << std::endl;
+
+		filter.reset();
+		console->Release();
+		return mismatchCount ? 1 : 0;
+	}
+};
+
+int main(int argc, char* argv[])
+{
+	uint32_t iterations = argc > 1 ? (uint32_t)strtoul(argv[1], nullptr, 10) : 200;
+	return VideoFilterBench::Run(iterations);
+}
@@ -54,6 +54,12 @@ static constexpr const char* MesenSuperFxOverclock = "mesen-s_superfx_overclock"
 static constexpr const char* MesenGbModel = "mesen-s_gbmodel";
 static constexpr const char* MesenGbSgb2 = "mesen-s_sgb2";
 static constexpr const char* MesenHLE = "mesen-s_hle_coprocessor";
+static constexpr const char* MesenCoprocessorSync = "mesen-s_coprocessor_sync";
+static constexpr const char* MesenIdleLoopSkip = "mesen-s_idle_loop_skip";
+static constexpr const char* MesenPpuThread = "mesen-s_ppu_thread";
+static constexpr const char* MesenLineCache = "mesen-s_line_cache";
+static constexpr const char* MesenVideoPipeline = "mesen-s_video_pipeline";
+static constexpr const char* MesenPerfCounters = "mesen-s_log_perf_counters";
 
 extern "C" {
 	void logMessage(retro_log_level level, const char* message)
@@ -128,6 +134,12 @@ extern "C" {
 			{ MesenSuperFxOverclock, "Super FX Clock Speed; 100%|200%|300%|400%|500%|1000%" },
 			{ MesenRamState, "Default power-on state for RAM; Random Values (Default)|All 0s|All 1s" },
 			{ MesenHLE, "Use HLE coprocessor emulation; disabled|enabled" },
+			{ MesenCoprocessorSync, "SA-1/Super FX/CX4 Sync; Fast|Accurate" },
+			{ MesenIdleLoopSkip, "Skip CPU idle loops; enabled|disabled" },
+			{ MesenPpuThread, "Draw scanlines on a separate thread; disabled|enabled" },
+			{ MesenLineCache, "Skip drawing unchanged scanlines; enabled|disabled" },
+			{ MesenVideoPipeline, "Filter video on a separate thread (adds 1 frame of latency); disabled|enabled" },
+			{ MesenPerfCounters, "Log performance counters; disabled|enabled" },
 			{ NULL, NULL },
 		};
 
@@ -392,6 +404,39 @@ extern "C" {
 			emulation.EnableHleCoprocessor = (value == "enabled");
 		}
 
+		emulation.CoprocessorSyncQuantum = 64;
+		if(readVariable(MesenCoprocessorSync, var)) {
+			string value = string(var.value);
+			if(value == "Accurate") {
+				emulation.CoprocessorSyncQuantum = 0;
+			}
+		}
+
+		if(readVariable(MesenIdleLoopSkip, var)) {
+			string value = string(var.value);
+			emulation.EnableIdleLoopSkipping = (value == "enabled");
+		}
+
+		if(readVariable(MesenPerfCounters, var)) {
+			string value = string(var.value);
+			emulation.LogPerformanceCounters = (value == "enabled");
+		}
+
+		if(readVariable(MesenPpuThread, var)) {
+			string value = string(var.value);
+			video.EnableRenderThread = (value == "enabled");
+		}
+
+		if(readVariable(MesenLineCache, var)) {
+			string value = string(var.value);
+			video.EnableLineCache = (value == "enabled");
+		}
+
+		if(readVariable(MesenVideoPipeline, var)) {
+			string value = string(var.value);
+			video.EnablePipelinedDecode = (value == "enabled");
+		}
+
 		if(readVariable(MesenBlendHighRes, var)) {
 			string value = string(var.value);
 			video.BlendHighResolutionModes = (value == "enabled");
@@ -478,6 +523,11 @@ extern "C" {
 		}
 		_console->GetSettings()->SetEmulationConfig(cfg);
 
+		//Skip drawing/decoding the frame when the frontend doesn't use the video output (e.g run-ahead, netplay)
+		int audioVideoEnable = 0;
+		bool videoDisabled = retroEnv(RETRO_ENVIRONMENT_GET_AUDIO_VIDEO_ENABLE, &audioVideoEnable) && !(audioVideoEnable & 0x01);
+		_console->GetSettings()->SetFlagState(EmulationFlags::Headless, videoDisabled);
+
 		_console->RunSingleFrame();
 
 		if(updated) {
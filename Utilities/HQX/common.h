@@ -38,13 +38,29 @@
 #define trU   0x00000700
 #define trV   0x00000006
 
-/* RGB to YUV lookup table */
-extern uint32_t RGBtoYUV[16777216];
+/* RGB to YUV lookup tables (the product of each channel value with each coefficient) */
+extern double RGBtoY[3][256];
+extern double RGBtoU[3][256];
+extern double RGBtoV[3][256];
 
 static inline uint32_t rgb_to_yuv(uint32_t c)
 {
     // Mask against MASK_RGB to discard the alpha channel
-    return RGBtoYUV[MASK_RGB & c];
+    c &= MASK_RGB;
+    if (c == MASK_RGB) {
+        // The full 16M entry table this replaces never initialized the entry for white
+        return 0;
+    }
+
+    uint32_t r = c >> 16;
+    uint32_t g = (c >> 8) & 0xFF;
+    uint32_t b = c & 0xFF;
+
+    // Same products, added in the same order as the full table used, so the results are identical
+    uint32_t y = (uint32_t)(RGBtoY[0][r] + RGBtoY[1][g] + RGBtoY[2][b]);
+    uint32_t u = (uint32_t)(int32_t)(RGBtoU[0][r] + RGBtoU[1][g] + RGBtoU[2][b]) + 128;
+    uint32_t v = (uint32_t)(int32_t)(RGBtoV[0][r] + RGBtoV[1][g] + RGBtoV[2][b]) + 128;
+    return (y << 16) + (u << 8) + v;
 }
 
 /* Test if there is difference in color */
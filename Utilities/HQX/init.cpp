@@ -20,29 +20,32 @@
 #include <stdint.h>
 #include "hqx.h"
 
-uint32_t   RGBtoYUV[16777216];
-uint32_t   YUV1, YUV2;
+double     RGBtoY[3][256];
+double     RGBtoU[3][256];
+double     RGBtoV[3][256];
 
 void HQX_CALLCONV hqxInit(void)
 {
-    /* Initalize RGB to YUV lookup table */
-    uint32_t c, r, g, b, y, u, v;
-    for (c = 0; c < 16777215; c++) {
-        r = (c & 0xFF0000) >> 16;
-        g = (c & 0x00FF00) >> 8;
-        b = c & 0x0000FF;
-        y = (uint32_t)(0.299*r + 0.587*g + 0.114*b);
-        u = (uint32_t)(-0.169*r - 0.331*g + 0.5*b) + 128;
-        v = (uint32_t)(0.5*r - 0.419*g - 0.081*b) + 128;
-        RGBtoYUV[c] = (y << 16) + (u << 8) + v;
+    /* Initalize the per-channel RGB to YUV lookup tables */
+    for (uint32_t i = 0; i < 256; i++) {
+        RGBtoY[0][i] = 0.299*i;
+        RGBtoY[1][i] = 0.587*i;
+        RGBtoY[2][i] = 0.114*i;
+        RGBtoU[0][i] = -0.169*i;
+        RGBtoU[1][i] = -0.331*i;
+        RGBtoU[2][i] = 0.5*i;
+        RGBtoV[0][i] = 0.5*i;
+        RGBtoV[1][i] = -0.419*i;
+        RGBtoV[2][i] = -0.081*i;
     }
 }
 
-void HQX_CALLCONV hqx(uint32_t scale, uint32_t * src, uint32_t * dest, int width, int height)
+void HQX_CALLCONV hqx(uint32_t scale, uint32_t * src, uint32_t * dest, int width, int height, int yFirst, int yLast)
 {
+	uint32_t rowBytes = width * 4;
 	switch(scale) {
-		case 2: hq2x_32(src, dest, width, height); break;
-		case 3: hq3x_32(src, dest, width, height); break;
-		case 4: hq4x_32(src, dest, width, height); break;
+		case 2: hq2x_32_rb(src, rowBytes, dest, rowBytes * 2, width, height, yFirst, yLast); break;
+		case 3: hq3x_32_rb(src, rowBytes, dest, rowBytes * 3, width, height, yFirst, yLast); break;
+		case 4: hq4x_32_rb(src, rowBytes, dest, rowBytes * 4, width, height, yFirst, yLast); break;
 	}
 }
\ No newline at end of file
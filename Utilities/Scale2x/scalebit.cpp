@@ -471,3 +471,95 @@ void scale(unsigned scale, void* void_dst, unsigned dst_slice, const void* void_
 	}
 }
 
+/**
+ * Clamp a row index to the bitmap. Used internally.
+ */
+static inline unsigned char* slice_row(const void* void_src, unsigned src_slice, int row, unsigned height)
+{
+	if (row < 0)
+		row = 0;
+	else if (row >= (int)height)
+		row = height - 1;
+	return (unsigned char*)void_src + row * src_slice;
+}
+
+/**
+ * Apply the Scale effect on a range of rows of a bitmap.
+ * The result is identical to the same rows of the bitmap produced by ::scale(),
+ * so separate ranges of rows of the same bitmap can be processed in parallel.
+ * \param scale Scale factor. 2, 203 (for 2x3), 204 (for 2x4), 3 or 4.
+ * \param void_dst Pointer at the first pixel of the destination bitmap.
+ * \param dst_slice Size in bytes of a destination bitmap row.
+ * \param void_src Pointer at the first pixel of the source bitmap.
+ * \param src_slice Size in bytes of a source bitmap row.
+ * \param pixel Bytes per pixel of the source and destination bitmap.
+ * \param width Horizontal size in pixels of the source bitmap.
+ * \param height Vertical size in pixels of the source bitmap.
+ * \param y_first First source row to process.
+ * \param y_last Source row after the last row to process.
+ */
+void scale_slice(unsigned scale, void* void_dst, unsigned dst_slice, const void* void_src, unsigned src_slice, unsigned pixel, unsigned width, unsigned height, unsigned y_first, unsigned y_last)
+{
+	unsigned char* dst;
+	int y;
+
+	if (y_last > height)
+		y_last = height;
+	if (y_first >= y_last)
+		return;
+
+	switch (scale) {
+	case 202 :
+	case 2 :
+		for (y = y_first; y < (int)y_last; ++y) {
+			dst = (unsigned char*)void_dst + 2 * y * dst_slice;
+			stage_scale2x(SCDST(0), SCDST(1), slice_row(void_src, src_slice, y - 1, height), slice_row(void_src, src_slice, y, height), slice_row(void_src, src_slice, y + 1, height), pixel, width);
+		}
+		break;
+	case 203 :
+		for (y = y_first; y < (int)y_last; ++y) {
+			dst = (unsigned char*)void_dst + 3 * y * dst_slice;
+			stage_scale2x3(SCDST(0), SCDST(1), SCDST(2), slice_row(void_src, src_slice, y - 1, height), slice_row(void_src, src_slice, y, height), slice_row(void_src, src_slice, y + 1, height), pixel, width);
+		}
+		break;
+	case 204 :
+		for (y = y_first; y < (int)y_last; ++y) {
+			dst = (unsigned char*)void_dst + 4 * y * dst_slice;
+			stage_scale2x4(SCDST(0), SCDST(1), SCDST(2), SCDST(3), slice_row(void_src, src_slice, y - 1, height), slice_row(void_src, src_slice, y, height), slice_row(void_src, src_slice, y + 1, height), pixel, width);
+		}
+		break;
+	case 303 :
+	case 3 :
+		for (y = y_first; y < (int)y_last; ++y) {
+			dst = (unsigned char*)void_dst + 3 * y * dst_slice;
+			stage_scale3x(SCDST(0), SCDST(1), SCDST(2), slice_row(void_src, src_slice, y - 1, height), slice_row(void_src, src_slice, y, height), slice_row(void_src, src_slice, y + 1, height), pixel, width);
+		}
+		break;
+	case 404 :
+	case 4 : {
+		/* scale2x the source rows around the slice, then scale2x these rows again (like ::scale4x_buf()) */
+		unsigned mid_slice = (2 * pixel * width + 0x7) & ~0x7;
+		int mid_first = y_first > 0 ? y_first - 1 : 0;
+		int mid_last = y_last < height ? y_last + 1 : height;
+		unsigned mid_height = 2 * (mid_last - mid_first);
+		unsigned char* mid = (unsigned char*)malloc(mid_height * mid_slice);
+
+		if (!mid)
+			return;
+
+		for (y = mid_first; y < mid_last; ++y) {
+			unsigned char* mid_row = mid + 2 * (y - mid_first) * mid_slice;
+			stage_scale2x(mid_row, mid_row + mid_slice, slice_row(void_src, src_slice, y - 1, height), slice_row(void_src, src_slice, y, height), slice_row(void_src, src_slice, y + 1, height), pixel, width);
+		}
+
+		for (y = y_first; y < (int)y_last; ++y) {
+			int mid_y = 2 * (y - mid_first);
+			dst = (unsigned char*)void_dst + 4 * y * dst_slice;
+			stage_scale4x(SCDST(0), SCDST(1), SCDST(2), SCDST(3), slice_row(mid, mid_slice, mid_y - 1, mid_height), slice_row(mid, mid_slice, mid_y, mid_height), slice_row(mid, mid_slice, mid_y + 1, mid_height), slice_row(mid, mid_slice, mid_y + 2, mid_height), pixel, width);
+		}
+
+		free(mid);
+		break;
+	}
+	}
+}
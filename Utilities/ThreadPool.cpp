@@ -0,0 +1,94 @@
+#include "stdafx.h"
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(uint32_t workerCount)
+{
+	_nextTask = 0;
+	for(uint32_t i = 0; i < workerCount; i++) {
+		_workers.push_back(unique_ptr<std::thread>(new std::thread(&ThreadPool::WorkerThread, this)));
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_stopFlag = true;
+	}
+	_startSignal.notify_all();
+
+	for(unique_ptr<std::thread> &worker : _workers) {
+		worker->join();
+	}
+}
+
+void ThreadPool::WorkerThread()
+{
+	uint32_t batchId = 0;
+	while(true) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_startSignal.wait(lock, [this, batchId] { return _stopFlag || _batchId != batchId; });
+			if(_stopFlag) {
+				return;
+			}
+			batchId = _batchId;
+		}
+
+		RunTasks();
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		_busyWorkers--;
+		if(_busyWorkers == 0) {
+			_doneSignal.notify_one();
+		}
+	}
+}
+
+void ThreadPool::RunTasks()
+{
+	uint32_t taskIndex;
+	while((taskIndex = _nextTask++) < _taskCount) {
+		(*_task)(taskIndex);
+	}
+}
+
+uint32_t ThreadPool::GetThreadCount()
+{
+	return (uint32_t)_workers.size() + 1;
+}
+
+void ThreadPool::Run(uint32_t taskCount, const std::function<void(uint32_t)> &task)
+{
+	if(_workers.empty() || taskCount <= 1) {
+		for(uint32_t i = 0; i < taskCount; i++) {
+			task(i);
+		}
+		return;
+	}
+
+	std::lock_guard<std::mutex> runLock(_runLock);
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_task = &task;
+		_taskCount = taskCount;
+		_nextTask = 0;
+		_busyWorkers = (uint32_t)_workers.size();
+		_batchId++;
+	}
+	_startSignal.notify_all();
+
+	RunTasks();
+
+	//Every worker takes part in each batch (even if there is no task left for it), so the next batch can't start while a worker is still reading this one's task
+	std::unique_lock<std::mutex> lock(_mutex);
+	_doneSignal.wait(lock, [this] { return _busyWorkers == 0; });
+	_task = nullptr;
+}
+
+ThreadPool* ThreadPool::GetSharedPool()
+{
+	//A frame only has a few hundred rows to split up, more than 16 threads would mostly sit idle
+	static ThreadPool pool(std::min(std::max(std::thread::hardware_concurrency(), 1u), 16u) - 1);
+	return &pool;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "stdafx.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+//Worker threads used to split expensive per-frame work (e.g video filters) into independent tasks
+class ThreadPool
+{
+private:
+	vector<unique_ptr<std::thread>> _workers;
+
+	std::mutex _mutex;
+	std::condition_variable _startSignal;
+	std::condition_variable _doneSignal;
+
+	//Only one batch of tasks can run at a time
+	std::mutex _runLock;
+
+	const std::function<void(uint32_t)> *_task = nullptr;
+	uint32_t _taskCount = 0;
+	atomic<uint32_t> _nextTask;
+	uint32_t _busyWorkers = 0;
+	uint32_t _batchId = 0;
+	bool _stopFlag = false;
+
+	void WorkerThread();
+	void RunTasks();
+
+public:
+	ThreadPool(uint32_t workerCount);
+	~ThreadPool();
+
+	//Number of threads that run tasks, including the thread that calls Run()
+	uint32_t GetThreadCount();
+
+	//Calls task(0) to task(taskCount - 1) on the workers and the calling thread, and returns once they are all done
+	void Run(uint32_t taskCount, const std::function<void(uint32_t)> &task);
+
+	//Pool with 1 worker per additional CPU core (up to 15), shared by all of the video filters
+	static ThreadPool* GetSharedPool();
+};
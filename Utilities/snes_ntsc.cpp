@@ -130,6 +130,71 @@ void snes_ntsc_init( snes_ntsc_t* ntsc, snes_ntsc_setup_t const* setup )
 
 #ifndef SNES_NTSC_NO_BLITTERS
 
+/* SNES_NTSC_NO_SIMD forces the scalar SNES_NTSC_RGB_OUT blitters (reference for
+Libretro/NtscFilterBench). The NEON path hasn't been built/checked against the scalar
+output on an ARM target yet, so it is only used when SNES_NTSC_ENABLE_NEON is defined. */
+#if (SNES_NTSC_OUT_DEPTH == 24 || SNES_NTSC_OUT_DEPTH == 32) && !defined (SNES_NTSC_NO_SIMD)
+	#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+		#include <emmintrin.h>
+		#define SNES_NTSC_USE_SSE2 1
+	#elif defined (SNES_NTSC_ENABLE_NEON) && (defined (__ARM_NEON) || defined (__ARM_NEON__))
+		#include <arm_neon.h>
+		#define SNES_NTSC_USE_NEON 1
+	#endif
+#endif
+
+#if SNES_NTSC_USE_SSE2 || SNES_NTSC_USE_NEON
+
+/* Sum of the kernels for output pixel x. Clamping and the 32-bit output only
+use the low 32 bits of the sum, so it can be truncated. */
+#define SNES_NTSC_RAW_SUM_( x ) (unsigned) (\
+	kernel0  [x       ] + kernel1  [(x+12)%7+14] + kernel2  [(x+10)%7+28] +\
+	kernelx0 [(x+7)%14] + kernelx1 [(x+ 5)%7+21] + kernelx2 [(x+ 3)%7+35])
+
+#define SNES_NTSC_HIRES_RAW_SUM_( x ) (unsigned) (\
+	kernel0  [ x       ] + kernel2  [(x+5)%7+14] + kernel4  [(x+3)%7+28] +\
+	kernelx0 [(x+7)%7+7] + kernelx2 [(x+5)%7+21] + kernelx4 [(x+3)%7+35] +\
+	kernel1  [(x+6)%7  ] + kernel3  [(x+4)%7+14] + kernel5  [(x+2)%7+28] +\
+	kernelx1 [(x+6)%7+7] + kernelx3 [(x+4)%7+21] + kernelx5 [(x+2)%7+35])
+
+/* Same as SNES_NTSC_CLAMP_ followed by SNES_NTSC_RGB_OUT_ (32-bit), on 4 raw sums at once */
+static inline void snes_ntsc_clamp_out_4( unsigned const* raw, snes_ntsc_out_t* rgb_out, int shift )
+{
+	#if SNES_NTSC_USE_SSE2
+		__m128i io    = _mm_loadu_si128( (__m128i const*) raw );
+		__m128i sub   = _mm_and_si128( _mm_srl_epi32( io, _mm_cvtsi32_si128( 9 - shift ) ),
+				_mm_set1_epi32( snes_ntsc_clamp_mask ) );
+		__m128i clamp = _mm_sub_epi32( _mm_set1_epi32( snes_ntsc_clamp_add ), sub );
+		__m128i r, g, b;
+		io    = _mm_or_si128( io, clamp );
+		clamp = _mm_sub_epi32( clamp, sub );
+		io    = _mm_and_si128( io, clamp );
+		
+		r = _mm_and_si128( _mm_srl_epi32( io, _mm_cvtsi32_si128( 5 - shift ) ), _mm_set1_epi32( 0xFF0000 ) );
+		g = _mm_and_si128( _mm_srl_epi32( io, _mm_cvtsi32_si128( 3 - shift ) ), _mm_set1_epi32( 0xFF00 ) );
+		b = _mm_and_si128( _mm_srl_epi32( io, _mm_cvtsi32_si128( 1 - shift ) ), _mm_set1_epi32( 0xFF ) );
+		_mm_storeu_si128( (__m128i*) rgb_out, _mm_or_si128( _mm_or_si128( r, g ),
+				_mm_or_si128( b, _mm_set1_epi32( (int) 0xFF000000 ) ) ) );
+	#else
+		uint32x4_t io    = vld1q_u32( raw );
+		uint32x4_t sub   = vandq_u32( vshlq_u32( io, vdupq_n_s32( shift - 9 ) ),
+				vdupq_n_u32( snes_ntsc_clamp_mask ) );
+		uint32x4_t clamp = vsubq_u32( vdupq_n_u32( snes_ntsc_clamp_add ), sub );
+		uint32x4_t r, g, b;
+		io    = vorrq_u32( io, clamp );
+		clamp = vsubq_u32( clamp, sub );
+		io    = vandq_u32( io, clamp );
+		
+		r = vandq_u32( vshlq_u32( io, vdupq_n_s32( shift - 5 ) ), vdupq_n_u32( 0xFF0000 ) );
+		g = vandq_u32( vshlq_u32( io, vdupq_n_s32( shift - 3 ) ), vdupq_n_u32( 0xFF00 ) );
+		b = vandq_u32( vshlq_u32( io, vdupq_n_s32( shift - 1 ) ), vdupq_n_u32( 0xFF ) );
+		vst1q_u32( (uint32_t*) rgb_out, vorrq_u32( vorrq_u32( r, g ),
+				vorrq_u32( b, vdupq_n_u32( 0xFF000000 ) ) ) );
+	#endif
+}
+
+#endif
+
 void snes_ntsc_blit( snes_ntsc_t const* ntsc, SNES_NTSC_IN_T const* input, long in_row_width,
 		int burst_phase, int in_width, int in_height, void* rgb_out, long out_pitch )
 {
@@ -143,6 +208,33 @@ void snes_ntsc_blit( snes_ntsc_t const* ntsc, SNES_NTSC_IN_T const* input, long
 		int n;
 		++line_in;
 		
+	#if SNES_NTSC_USE_SSE2 || SNES_NTSC_USE_NEON
+		unsigned raw [8];
+		raw [7] = 0;
+		for ( n = chunk_count; n; --n )
+		{
+			/* sums are computed one at a time, then clamped and output 4 at a time */
+			SNES_NTSC_COLOR_IN( 0, SNES_NTSC_ADJ_IN( line_in [0] ) );
+			raw [0] = SNES_NTSC_RAW_SUM_( 0 );
+			raw [1] = SNES_NTSC_RAW_SUM_( 1 );
+			
+			SNES_NTSC_COLOR_IN( 1, SNES_NTSC_ADJ_IN( line_in [1] ) );
+			raw [2] = SNES_NTSC_RAW_SUM_( 2 );
+			raw [3] = SNES_NTSC_RAW_SUM_( 3 );
+			
+			SNES_NTSC_COLOR_IN( 2, SNES_NTSC_ADJ_IN( line_in [2] ) );
+			raw [4] = SNES_NTSC_RAW_SUM_( 4 );
+			raw [5] = SNES_NTSC_RAW_SUM_( 5 );
+			raw [6] = SNES_NTSC_RAW_SUM_( 6 );
+			
+			/* 8th pixel is junk, and is overwritten by the next chunk (or the final pixels) */
+			snes_ntsc_clamp_out_4( raw, line_out, 1 );
+			snes_ntsc_clamp_out_4( raw + 4, line_out + 4, 1 );
+			
+			line_in  += 3;
+			line_out += 7;
+		}
+	#else
 		for ( n = chunk_count; n; --n )
 		{
 			/* order of input and output pixels must not be altered */
@@ -162,6 +254,7 @@ void snes_ntsc_blit( snes_ntsc_t const* ntsc, SNES_NTSC_IN_T const* input, long
 			line_in  += 3;
 			line_out += 7;
 		}
+	#endif
 		
 		/* finish final pixels */
 		SNES_NTSC_COLOR_IN( 0, snes_ntsc_black );
@@ -198,6 +291,39 @@ void snes_ntsc_blit_hires( snes_ntsc_t const* ntsc, SNES_NTSC_IN_T const* input,
 		int n;
 		line_in += 2;
 		
+	#if SNES_NTSC_USE_SSE2 || SNES_NTSC_USE_NEON
+		unsigned raw [8];
+		raw [7] = 0;
+		for ( n = chunk_count; n; --n )
+		{
+			/* twice as many input pixels per chunk */
+			SNES_NTSC_COLOR_IN( 0, SNES_NTSC_ADJ_IN( line_in [0] ) );
+			raw [0] = SNES_NTSC_HIRES_RAW_SUM_( 0 );
+			
+			SNES_NTSC_COLOR_IN( 1, SNES_NTSC_ADJ_IN( line_in [1] ) );
+			raw [1] = SNES_NTSC_HIRES_RAW_SUM_( 1 );
+			
+			SNES_NTSC_COLOR_IN( 2, SNES_NTSC_ADJ_IN( line_in [2] ) );
+			raw [2] = SNES_NTSC_HIRES_RAW_SUM_( 2 );
+			
+			SNES_NTSC_COLOR_IN( 3, SNES_NTSC_ADJ_IN( line_in [3] ) );
+			raw [3] = SNES_NTSC_HIRES_RAW_SUM_( 3 );
+			
+			SNES_NTSC_COLOR_IN( 4, SNES_NTSC_ADJ_IN( line_in [4] ) );
+			raw [4] = SNES_NTSC_HIRES_RAW_SUM_( 4 );
+			
+			SNES_NTSC_COLOR_IN( 5, SNES_NTSC_ADJ_IN( line_in [5] ) );
+			raw [5] = SNES_NTSC_HIRES_RAW_SUM_( 5 );
+			raw [6] = SNES_NTSC_HIRES_RAW_SUM_( 6 );
+			
+			/* 8th pixel is junk, and is overwritten by the next chunk (or the final pixels) */
+			snes_ntsc_clamp_out_4( raw, line_out, 0 );
+			snes_ntsc_clamp_out_4( raw + 4, line_out + 4, 0 );
+			
+			line_in  += 6;
+			line_out += 7;
+		}
+	#else
 		for ( n = chunk_count; n; --n )
 		{
 			/* twice as many input pixels per chunk */
@@ -223,6 +349,7 @@ void snes_ntsc_blit_hires( snes_ntsc_t const* ntsc, SNES_NTSC_IN_T const* input,
 			line_in  += 6;
 			line_out += 7;
 		}
+	#endif
 		
 		SNES_NTSC_COLOR_IN( 0, snes_ntsc_black );
 		SNES_NTSC_HIRES_OUT( 0, line_out [0], SNES_NTSC_OUT_DEPTH );